@@ -1,8 +1,62 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
-
-template <typename T>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+Traversals prefetch the first cache lines of the keys of the node ARRAY_LINKED_LIST_PREFETCH_DISTANCE nodes ahead of the
+current one (1 by default), and the successor of that node. Define ARRAY_LINKED_LIST_NO_PREFETCH or a distance of 0
+to disable this, or ARRAY_LINKED_LIST_PREFETCH_LINES to change how many cache lines of a keys block are prefetched.
+benchmark/TraversalBenchmark.cpp compares the distances
+*/
+#if !defined(ARRAY_LINKED_LIST_NO_PREFETCH) && (defined(__GNUC__) || defined(__clang__))
+#define ARRAY_LINKED_LIST_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define ARRAY_LINKED_LIST_PREFETCH(address) ((void)(address))
+#undef ARRAY_LINKED_LIST_PREFETCH_DISTANCE
+#define ARRAY_LINKED_LIST_PREFETCH_DISTANCE 0
+#endif
+
+#ifndef ARRAY_LINKED_LIST_PREFETCH_DISTANCE
+#define ARRAY_LINKED_LIST_PREFETCH_DISTANCE 1
+#endif
+
+#ifndef ARRAY_LINKED_LIST_PREFETCH_LINES
+#define ARRAY_LINKED_LIST_PREFETCH_LINES 2
+#endif
+
+// Instrumentation of the hot paths, which compiles to nothing unless ARRAY_LINKED_LIST_TRACING is defined (see ArrayLinkedListTrace.h)
+#ifdef ARRAY_LINKED_LIST_TRACING
+#include "ArrayLinkedListTrace.h"
+#define ARRAY_LINKED_LIST_TRACE_SCOPE(operation) TraceScope array_linked_list_trace_scope_(TraceOperation::operation)
+#define ARRAY_LINKED_LIST_TRACE_NODES(count) array_linked_list_trace_scope_.add_nodes(count)
+#define ARRAY_LINKED_LIST_TRACE_SHIFTED(count) array_linked_list_trace_scope_.add_shifted(count)
+#else
+#define ARRAY_LINKED_LIST_TRACE_SCOPE(operation) ((void)0)
+#define ARRAY_LINKED_LIST_TRACE_NODES(count) ((void)0)
+#define ARRAY_LINKED_LIST_TRACE_SHIFTED(count) ((void)0)
+#endif
+
+/*
+Nodes and their keys are allocated with the given allocator (rebound to the node type for the nodes themselves),
+which makes it possible to control where the nodes are placed in memory (see HugePageAllocator.h).
+If InlineCapacity is not 0, the first InlineCapacity keys (at most node_size of them) are stored in a buffer inside
+the list object, so small lists do not allocate any nodes. The keys are moved to a node on the heap once the buffer
+overflows, which invalidates iterators like any other reallocation. Moving a list that still uses its buffer moves the keys
+*/
+template <typename T, typename Allocator = std::allocator<T>, size_t InlineCapacity = 0>
 class ArrayLinkedList {
     class Node {
        public:
@@ -11,18 +65,59 @@ class ArrayLinkedList {
         Node* next;
         Node* prev;
 
-        Node(size_t alloc_size, Node* prev = nullptr) :
-            keys(new T[alloc_size]), 
-            next(nullptr), 
+        // The keys are allocated and freed by the list, because it owns the allocator
+        Node(T* keys, Node* prev = nullptr) :
+            keys(keys),
+            next(nullptr),
             prev(prev) {}
-
-        ~Node() {
-            delete[] keys;
-        }
     };
 
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    using NodeAllocator = typename AllocatorTraits::template rebind_alloc<Node>;
+    using NodeAllocatorTraits = std::allocator_traits<NodeAllocator>;
+
+    // Keys of these types are left uninitialised until they are assigned to, like with new T[]
+    static constexpr bool s_trivial_keys_ = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+    static constexpr bool s_nothrow_copy_assign_ = std::is_nothrow_copy_assignable_v<T>;
+    static constexpr bool s_nothrow_move_assign_ = std::is_nothrow_move_assignable_v<T>;
+
+    /*
+    Like std::move_if_noexcept, but for assignment: keys are only moved between positions if moving cannot throw,
+    otherwise they are copied, so the source key is still intact if the assignment fails
+    */
+    static std::conditional_t<s_nothrow_move_assign_ || !std::is_copy_assignable_v<T>, T&&, const T&> move_or_copy(T& key) noexcept {
+        return std::move(key);
+    }
+
     static const size_t s_default_node_size_ = 50;
 
+    // Batches of at most this many keys are compared directly in find_many, larger ones are looked up in a hash map
+    static const size_t s_probe_block_size_ = 16;
+
+    static const size_t s_cache_line_size_ = 64;
+    static const size_t s_prefetch_lines_ = ARRAY_LINKED_LIST_PREFETCH_LINES;
+    static const size_t s_prefetch_distance_ = ARRAY_LINKED_LIST_PREFETCH_DISTANCE;
+
+    // Storage of the only node of a list, as long as its keys fit into the inline buffer
+    class InlineBuffer {
+       public:
+        std::array<T, InlineCapacity> keys;
+        Node node;
+
+        InlineBuffer() :
+            keys(),
+            node(keys.data()) {}
+
+        InlineBuffer(const InlineBuffer& other) = delete;
+        InlineBuffer& operator=(const InlineBuffer& other) = delete;
+    };
+
+    class NoInlineBuffer {};
+
+    Allocator allocator_;
+    std::conditional_t<(InlineCapacity > 0), InlineBuffer, NoInlineBuffer> inline_buffer_;
+
     Node* head_;
     Node* tail_;
 
@@ -30,23 +125,75 @@ class ArrayLinkedList {
     size_t node_count_;
     size_t tail_size_;
 
+    // State of nodes shared by lists created with snapshot()
+    class SharedNodes {
+       public:
+        // Number of lists sharing the nodes
+        std::atomic<size_t> owners;
+
+        // Number of items written to the shared nodes, only the list that has this size may append to them
+        std::atomic<size_t> appended_size;
+
+        explicit SharedNodes(size_t size) :
+            owners(1),
+            appended_size(size) {}
+    };
+
+    /*
+    Lists created by snapshot() share their nodes with the list they were taken from. shared_ points to the state of the
+    shared nodes, or is nullptr if the nodes are not shared. Every function that changes items or hands out mutable access
+    to them calls detach() first, which copies the nodes if they are still shared. Appending only writes behind the end
+    of all other lists sharing the nodes, so it does not detach (see detach_for_append()).
+    As a list sharing nodes may be followed by nodes another list appended, traversals stop at tail_ instead of following
+    its next pointer. The pointer itself is atomic, because snapshot() only has const access and may create the state
+    while other threads take snapshots of the same list
+    */
+    mutable std::atomic<SharedNodes*> shared_;
+
+    /*
+    Called when a traversal enters the given node. The nodes up to s_prefetch_distance_ nodes ahead should already be
+    cached, because each of them was prefetched as a successor when an earlier node was entered. So only the keys of the
+    node s_prefetch_distance_ nodes ahead and the successor of that node are prefetched here
+    */
+    static void prefetch_following(const Node* node, const Node* tail, size_t node_size) {
+        if (s_prefetch_distance_ == 0)
+            return;
+
+        const Node* ahead = node;
+        for (size_t i = 0; i < s_prefetch_distance_; ++i) {
+            if (ahead == tail || ahead->next == nullptr)
+                return;
+            ahead = ahead->next;
+        }
+
+        if (ahead != tail)
+            ARRAY_LINKED_LIST_PREFETCH(ahead->next);
+
+        const char* keys = reinterpret_cast<const char*>(ahead->keys);
+        size_t keys_lines = (node_size * sizeof(T) + s_cache_line_size_ - 1) / s_cache_line_size_;
+        for (size_t i = 0; i < s_prefetch_lines_ && i < keys_lines; ++i)
+            ARRAY_LINKED_LIST_PREFETCH(keys + i * s_cache_line_size_);
+    }
+
     // Iterator class declarations
 
    private:
     template <bool constant, bool reverse>
     class Iterator {
-        friend class ArrayLinkedList<T>;
+        friend class ArrayLinkedList<T, Allocator, InlineCapacity>;
 
         Node* current_node_;
         size_t index_;
         size_t node_size_;
         const size_t* tail_size_;
+        Node* const* tail_;
 
-        Iterator(Node* current_node, size_t index, size_t node_size, const size_t* tail_size) :
+        Iterator(Node* current_node, size_t index, size_t node_size, const size_t* tail_size, Node* const* tail) :
             current_node_(current_node), 
             index_(index),
             node_size_(node_size),
-            tail_size_(tail_size) {}
+            tail_size_(tail_size),
+            tail_(tail) {}
        public:
 
         using value_type = T;
@@ -55,15 +202,19 @@ class ArrayLinkedList {
             current_node_(nullptr),
             index_(0),
             node_size_(0),
-            tail_size_(nullptr) {}
+            tail_size_(nullptr),
+            tail_(nullptr) {}
 
        private:
         void next_item() {
-            if ((current_node_->next == nullptr && index_ < *tail_size_ - 1) || (current_node_->next != nullptr && index_ < node_size_ - 1)) {
+            bool at_tail = current_node_ == *tail_;
+            if (index_ < (at_tail ? *tail_size_ : node_size_) - 1) {
                 ++index_;
             } else {
-                current_node_ = current_node_->next;
+                current_node_ = at_tail ? nullptr : current_node_->next;
                 index_ = 0;
+                if (current_node_ != nullptr)
+                    prefetch_following(current_node_, *tail_, node_size_);
             }
         }
 
@@ -136,91 +287,340 @@ class ArrayLinkedList {
 
    private:
 
-    static void free_following_nodes(Node* start) {
+    void destroy_keys(T* keys, size_t count) {
+        if constexpr (!s_trivial_keys_) {
+            for (size_t i = 0; i < count; ++i)
+                AllocatorTraits::destroy(allocator_, keys + i);
+        }
+    }
+
+    // Allocates a node with node_size_ default constructed keys
+    Node* new_node(Node* prev = nullptr) {
+        T* keys = AllocatorTraits::allocate(allocator_, node_size_);
+        size_t constructed = 0;
+        try {
+            if constexpr (!s_trivial_keys_) {
+                for (; constructed < node_size_; ++constructed)
+                    AllocatorTraits::construct(allocator_, keys + constructed);
+            }
+
+            NodeAllocator node_allocator(allocator_);
+            Node* node = NodeAllocatorTraits::allocate(node_allocator, 1);
+            NodeAllocatorTraits::construct(node_allocator, node, keys, prev);
+            return node;
+        } catch (...) {
+            destroy_keys(keys, constructed);
+            AllocatorTraits::deallocate(allocator_, keys, node_size_);
+            throw;
+        }
+    }
+
+    void delete_node(Node* node) {
+        destroy_keys(node->keys, node_size_);
+        AllocatorTraits::deallocate(allocator_, node->keys, node_size_);
+
+        NodeAllocator node_allocator(allocator_);
+        NodeAllocatorTraits::destroy(node_allocator, node);
+        NodeAllocatorTraits::deallocate(node_allocator, node, 1);
+    }
+
+    Node* inline_node() {
+        if constexpr (InlineCapacity > 0)
+            return &inline_buffer_.node;
+        else
+            return nullptr;
+    }
+
+    bool is_inline(const Node* node) const {
+        if constexpr (InlineCapacity > 0)
+            return node == &inline_buffer_.node;
+        else
+            return false;
+    }
+
+    size_t inline_capacity() const {
+        return InlineCapacity < node_size_ ? InlineCapacity : node_size_;
+    }
+
+    // Moves the keys of the inline buffer into a node on the heap, which becomes the first node of the list, and inserts
+    // the new key with func. The new key is inserted first, as it may refer to a key of the inline buffer
+    template <typename Function>
+    void spill_inline_node(Function func) {
+        size_t inline_size = tail_size_;
+        Node* node = new_node();
+        Node* next = nullptr;
+        try {
+            if (inline_size == node_size_) {
+                next = new_node(node);
+                tail_size_ = 0;
+                func(next);
+            } else {
+                func(node);
+            }
+
+            for (size_t i = 0; i < inline_size; ++i)
+                node->keys[i] = move_or_copy(head_->keys[i]);
+        } catch (...) {
+            tail_size_ = inline_size;
+            if (next != nullptr)
+                delete_node(next);
+            delete_node(node);
+            throw;
+        }
+
+        node->next = next;
+        head_ = node;
+        tail_ = next != nullptr ? next : node;
+        node_count_ = next != nullptr ? 2 : 1;
+    }
+
+    // Appends an empty node on the heap and makes it the tail
+    void append_node() {
+        if (head_ == nullptr) {
+            head_ = tail_ = new_node();
+        } else {
+            tail_->next = new_node(tail_);
+            tail_ = tail_->next;
+        }
+        ++node_count_;
+        tail_size_ = 0;
+    }
+
+    void free_following_nodes(Node* start) {
         Node* it = start;
         while (it != nullptr) {
             Node* tmp = it;
             it = it->next;
-            delete tmp;
+            if (it != nullptr) {
+                ARRAY_LINKED_LIST_PREFETCH(it->next);
+                ARRAY_LINKED_LIST_PREFETCH(it->keys);
+            }
+            if (!is_inline(tmp))
+                delete_node(tmp);
         }
     }
 
+    // The last owner of shared nodes also frees the nodes other lists appended behind its tail
     void _free() {
+        SharedNodes* shared = shared_.load(std::memory_order_acquire);
+        if (shared != nullptr) {
+            bool last_owner = shared->owners.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            if (last_owner)
+                delete shared;
+            shared_.store(nullptr, std::memory_order_relaxed);
+
+            if (!last_owner)
+                return;
+        }
         free_following_nodes(head_);
     }
 
-    static void copy_arr(T* to, T* from, size_t size) {
-        for (size_t i = 0; i < size; ++i)
-            to[i] = from[i];
+    // Gives this list its own copy of its nodes if they are shared with a snapshot
+    void detach() {
+        SharedNodes* shared = shared_.load(std::memory_order_acquire);
+        if (shared == nullptr)
+            return;
+
+        if (shared->owners.load(std::memory_order_acquire) == 1) {
+            // Nodes appended by lists that do not exist anymore are not needed by this list
+            free_following_nodes(tail_->next);
+            tail_->next = nullptr;
+            delete shared;
+            shared_.store(nullptr, std::memory_order_relaxed);
+            return;
+        }
+
+        // If copying throws, this list still shares the nodes
+        auto [head, tail] = copy_following_nodes(head_, tail_, tail_size_);
+        Node* shared_head = head_;
+        head_ = head;
+        tail_ = tail;
+        shared_.store(nullptr, std::memory_order_relaxed);
+
+        if (shared->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            free_following_nodes(shared_head);
+            delete shared;
+        }
     }
 
-    void append_following_nodes(Node* copy_begin) {
-        if (head_ == nullptr)
-            head_ = tail_ = new Node(node_size_);
-        else {
-            tail_->next = new Node(node_size_, tail_);
-            tail_ = tail_->next;
+    /*
+    Called instead of detach() before appending an item. Items behind the end of a list are never read by it, so the nodes
+    stay shared if no other list sharing them has more items than this one. Of several lists with that size, only the first
+    one to append keeps sharing the nodes, the others detach when they append
+    */
+    void detach_for_append() {
+        SharedNodes* shared = shared_.load(std::memory_order_acquire);
+        if (shared == nullptr)
+            return;
+
+        size_t current_size = size();
+        if (shared->owners.load(std::memory_order_acquire) > 1 && shared->appended_size.compare_exchange_strong(current_size, current_size + 1, std::memory_order_acq_rel))
+            return;
+        detach();
+    }
+
+    // Returns the node following the given node in this list, which is nullptr for the tail
+    Node* next_node(const Node* node) const {
+        return node == tail_ ? nullptr : node->next;
+    }
+
+    // Returns the number of the given node in this list, or node_count_ for nullptr (the node of end())
+    size_t node_number(const Node* node) const {
+        size_t result = 0;
+        for (const Node* it = head_; it != node; it = next_node(it))
+            ++result;
+        return result;
+    }
+
+    Node* node_at(size_t number) const {
+        Node* it = head_;
+        for (size_t i = 0; i < number; ++i)
+            it = next_node(it);
+        return it;
+    }
+
+    /*
+    detach() for functions that are passed iterators into this list. Const iterators can be obtained without detaching,
+    so they may still point into the shared nodes. They are moved to the same position in the copied nodes
+    */
+    template <typename ItType>
+    void detach(ItType& first, ItType& last) {
+        if (shared_.load(std::memory_order_acquire) == nullptr)
+            return;
+
+        size_t first_node = node_number(first.current_node_);
+        size_t last_node = node_number(last.current_node_);
+        detach();
+        first.current_node_ = node_at(first_node);
+        last.current_node_ = node_at(last_node);
+    }
+
+    static void copy_arr(T* to, const T* from, size_t size) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size != 0)
+                std::memcpy(to, from, size * sizeof(T));
+        } else {
+            for (size_t i = 0; i < size; ++i)
+                to[i] = from[i];
         }
+    }
 
-        for (Node* it = copy_begin; it != nullptr; it = it->next) {
-            if (it->next != nullptr) {
-                copy_arr(tail_->keys, it->keys, node_size_);
-                tail_->next = new Node(node_size_, tail_);
-                tail_ = tail_->next;
-            } else {
-                copy_arr(tail_->keys, it->keys, tail_size_);
+    /*
+    Copies the nodes from copy_begin to copy_last into a new chain, where the last node holds last_size keys.
+    Returns the first and last node of the chain, which is not linked to this list yet. If a copy throws, the chain is freed
+    again, so splicing the result in afterwards gives the strong guarantee
+    */
+    std::pair<Node*, Node*> copy_following_nodes(const Node* copy_begin, const Node* copy_last, size_t last_size) {
+        Node* head = new_node();
+        Node* tail = head;
+        try {
+            for (const Node* it = copy_begin; it != copy_last; it = it->next) {
+                copy_arr(tail->keys, it->keys, node_size_);
+                tail->next = new_node(tail);
+                tail = tail->next;
             }
+            copy_arr(tail->keys, copy_last->keys, last_size);
+        } catch (...) {
+            free_following_nodes(head);
+            throw;
         }
+        return std::make_pair(head, tail);
+    }
+
+    // Appends a copy of the nodes from copy_begin to copy_last, the counters have to be updated by the caller
+    void append_following_nodes(const Node* copy_begin, const Node* copy_last, size_t last_size) {
+        auto [head, tail] = copy_following_nodes(copy_begin, copy_last, last_size);
+        if (head_ == nullptr) {
+            head_ = head;
+        } else {
+            tail_->next = head;
+            head->prev = tail_;
+        }
+        tail_ = tail;
     }
 
     /*
-    If 2 lists have the same node size, we only need to copy the contents of the nodes of the other list into this list 
-    and append the other nodes, or delete the nodes that are too much
+    If 2 lists have the same node size, we only need to copy the contents of the nodes of the other list into this list
+    and append the other nodes, or delete the nodes that are too much.
+    This is only used if copy assigning T cannot throw, so the nodes to append are copied first, as they are the only step
+    that can fail (by running out of memory)
     */
-    void _copy_same_node_size(const ArrayLinkedList<T>& other) {
-        node_count_ = other.node_count_;
-        tail_size_ = other.tail_size_;
-        Node* it = head_;
-        Node* other_it = other.head_;
+    void _copy_same_node_size(const ArrayLinkedList<T, Allocator, InlineCapacity>& other) {
+        Node* excess = head_;
+        const Node* missing = other.head_;
+        while (excess != nullptr && missing != nullptr) {
+            excess = excess->next;
+            missing = other.next_node(missing);
+        }
+
+        std::pair<Node*, Node*> appended(nullptr, nullptr);
+        if (missing != nullptr)
+            appended = copy_following_nodes(missing, other.tail_, other.tail_size_);
 
-        while (it != nullptr && other_it != nullptr) {
-            size_t copy_size = other_it->next == nullptr ? tail_size_ : node_size_;
+        Node* it = head_;
+        const Node* other_it = other.head_;
+        while (it != excess && other_it != missing) {
+            size_t copy_size = other_it == other.tail_ ? other.tail_size_ : node_size_;
             copy_arr(it->keys, other_it->keys, copy_size);
 
             it = it->next;
-            other_it = other_it->next;
+            other_it = other.next_node(other_it);
         }
 
-        if (other_it == nullptr && it != nullptr) {
-            tail_ = it->prev;
-            tail_->next = nullptr;
-            free_following_nodes(it);
-        } else if (other_it != nullptr && it == nullptr) {
-            append_following_nodes(other_it);
+        if (excess != nullptr) {
+            tail_ = excess->prev;
+            if (tail_ == nullptr)
+                head_ = nullptr;
+            else
+                tail_->next = nullptr;
+            free_following_nodes(excess);
+        } else if (appended.first != nullptr) {
+            if (head_ == nullptr) {
+                head_ = appended.first;
+            } else {
+                tail_->next = appended.first;
+                appended.first->prev = tail_;
+            }
+            tail_ = appended.second;
         }
-    }
 
-    void _copy(const ArrayLinkedList<T>& other) {
-        node_size_ = other.node_size_;
         node_count_ = other.node_count_;
         tail_size_ = other.tail_size_;
+    }
 
-        // This is so head does not stay uninitialised in the function call
-        head_ = nullptr;
-        append_following_nodes(other.head_);
+    // Copies other into this list, which has to be empty. If a copy throws, this list stays empty.
+    // Unless keep_inline is set, the keys of an inline list are copied to a node on the heap
+    void _copy(const ArrayLinkedList<T, Allocator, InlineCapacity>& other, bool keep_inline = true) {
+        _init(other.node_size_);
+        if (other.is_inline(other.head_) && keep_inline) {
+            copy_arr(inline_node()->keys, other.head_->keys, other.tail_size_);
+            head_ = tail_ = inline_node();
+        } else if (other.head_ != nullptr) {
+            append_following_nodes(other.head_, other.tail_, other.tail_size_);
+        }
+        node_count_ = other.node_count_;
+        tail_size_ = other.tail_size_;
     }
 
-    void _move(ArrayLinkedList<T>&& other) {
+    void _move(ArrayLinkedList<T, Allocator, InlineCapacity>&& other) {
         node_size_ = other.node_size_;
         node_count_ = other.node_count_;
         tail_size_ = other.tail_size_;
         head_ = other.head_;
         tail_ = other.tail_;
+        shared_.store(other.shared_.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+        if (other.is_inline(other.head_)) {
+            head_ = tail_ = inline_node();
+            for (size_t i = 0; i < tail_size_; ++i)
+                head_->keys[i] = move_or_copy(other.head_->keys[i]);
+        }
 
         other.head_ = nullptr;
         other.tail_ = nullptr;
         other.node_count_ = 0;
         other.tail_size_ = 0;
+        other.shared_.store(nullptr, std::memory_order_relaxed);
     }
 
     void _init(size_t node_size) {
@@ -229,6 +629,7 @@ class ArrayLinkedList {
         node_size_ = node_size;
         node_count_ = 0;
         tail_size_ = 0;
+        shared_.store(nullptr, std::memory_order_relaxed);
     }
 
     void _init_list(std::initializer_list<T> list, size_t node_size) {
@@ -241,19 +642,23 @@ class ArrayLinkedList {
 
    public:
 
-    explicit ArrayLinkedList(size_t node_size = s_default_node_size_)  {
+    explicit ArrayLinkedList(size_t node_size = s_default_node_size_, const Allocator& allocator = Allocator()) :
+        allocator_(allocator) {
         _init(node_size);
     }
 
-    ArrayLinkedList(const ArrayLinkedList<T>& other) {
+    ArrayLinkedList(const ArrayLinkedList<T, Allocator, InlineCapacity>& other) :
+        allocator_(AllocatorTraits::select_on_container_copy_construction(other.allocator_)) {
         _copy(other);
     }
 
-    ArrayLinkedList(ArrayLinkedList<T>&& other) {
+    ArrayLinkedList(ArrayLinkedList<T, Allocator, InlineCapacity>&& other) :
+        allocator_(other.allocator_) {
         _move(std::move(other));
     }
 
-    ArrayLinkedList(std::initializer_list<T> init, size_t node_size = s_default_node_size_) {
+    ArrayLinkedList(std::initializer_list<T> init, size_t node_size = s_default_node_size_, const Allocator& allocator = Allocator()) :
+        allocator_(allocator) {
         _init_list(init, node_size);
     }
 
@@ -261,30 +666,86 @@ class ArrayLinkedList {
         _free();
     }
 
-    ArrayLinkedList<T>& operator=(const ArrayLinkedList<T>& other) {
-        if (node_size_ == other.node_size_)
+    ArrayLinkedList<T, Allocator, InlineCapacity>& operator=(const ArrayLinkedList<T, Allocator, InlineCapacity>& other) {
+        if (this == &other)
+            return *this;
+
+        /*
+        The nodes of a shared list must not be overwritten, so they are released instead of reused.
+        Reusing the nodes is only done if overwriting a key cannot throw, otherwise other is copied into a new list first,
+        so this list is left unchanged if a copy fails. Moving that copy into this list must not throw either, so inline
+        keys which may throw when moved are copied to a node on the heap, whose pointer is moved instead
+        */
+        if (s_nothrow_copy_assign_ && node_size_ == other.node_size_ && shared_.load(std::memory_order_acquire) == nullptr && !is_inline(head_) && !other.is_inline(other.head_)) {
             _copy_same_node_size(other);
-        else {
+        } else {
+            ArrayLinkedList<T, Allocator, InlineCapacity> copy(other.node_size_, allocator_);
+            copy._copy(other, s_nothrow_move_assign_);
             _free();
-            _copy(other);
+            _move(std::move(copy));
         }
         return *this;
     }
 
-    ArrayLinkedList<T>& operator=(ArrayLinkedList<T>&& other) {
+    ArrayLinkedList<T, Allocator, InlineCapacity>& operator=(ArrayLinkedList<T, Allocator, InlineCapacity>&& other) {
         _free();
+        // The nodes of other have to be freed with the allocator they were allocated with
+        allocator_ = other.allocator_;
         _move(std::move(other));
         return *this;
     }
 
-    ArrayLinkedList<T>& operator=(std::initializer_list<T> list) {
+    ArrayLinkedList<T, Allocator, InlineCapacity>& operator=(std::initializer_list<T> list) {
         _free();
         _init_list(list, node_size_);
         return *this;
     }
 
+    /*
+    Returns a list that shares the nodes of this list instead of copying them, which only costs a reference count increment.
+    Appending to the longest of the lists sharing the nodes (usually the list the snapshots were taken from) writes behind
+    the ends of all others, so it keeps sharing them. Any other change (or handing out mutable access to items) copies
+    all nodes of the changed list, so for those changes a snapshot only defers a full copy.
+    Iterators of this list that were obtained before the snapshot must not be used after it was taken.
+    Lists sharing nodes may be used from different threads, and several threads may take snapshots of the same list at once
+    */
+    ArrayLinkedList<T, Allocator, InlineCapacity> snapshot() const {
+        // The shared nodes may be freed by the snapshot, so it needs a copy of the allocator they were allocated with
+        ArrayLinkedList<T, Allocator, InlineCapacity> result(node_size_, allocator_);
+        if (head_ == nullptr)
+            return result;
+
+        // The inline buffer cannot be shared, but small enough to be copied
+        if (is_inline(head_)) {
+            result._copy(*this);
+            return result;
+        }
+
+        // Several threads may take snapshots of the same list at once, only one of them installs the shared state
+        SharedNodes* shared = shared_.load(std::memory_order_acquire);
+        if (shared == nullptr) {
+            SharedNodes* created = new SharedNodes(size());
+            if (shared_.compare_exchange_strong(shared, created, std::memory_order_acq_rel, std::memory_order_acquire))
+                shared = created;
+            else
+                delete created;
+        }
+        shared->owners.fetch_add(1, std::memory_order_relaxed);
+
+        result.head_ = head_;
+        result.tail_ = tail_;
+        result.node_count_ = node_count_;
+        result.tail_size_ = tail_size_;
+        result.shared_.store(shared, std::memory_order_relaxed);
+        return result;
+    }
+
     // Getters
 
+    Allocator get_allocator() const {
+        return allocator_;
+    }
+
     size_t node_size() const {
         return node_size_;
     }
@@ -301,6 +762,7 @@ class ArrayLinkedList {
     }
 
     T& front() {
+        detach();
         return head_->keys[0];
     }
 
@@ -309,6 +771,7 @@ class ArrayLinkedList {
     }
 
     T& back() {
+        detach();
         return tail_->keys[tail_size_ - 1];
     }
 
@@ -318,20 +781,21 @@ class ArrayLinkedList {
 
     // Functions for getting iterators
 
-    iterator begin() noexcept {
-        return iterator(head_, 0, node_size_, &tail_size_);
+    iterator begin() {
+        detach();
+        return iterator(head_, 0, node_size_, &tail_size_, &tail_);
     }
 
     iterator end() noexcept {
-        return iterator(nullptr, 0, node_size_, &tail_size_);
+        return iterator(nullptr, 0, node_size_, &tail_size_, &tail_);
     }
 
     const_iterator cbegin() const noexcept {
-        return const_iterator(head_, 0, node_size_, &tail_size_);
+        return const_iterator(head_, 0, node_size_, &tail_size_, &tail_);
     }
 
     const_iterator cend() const noexcept {
-        return const_iterator(nullptr, 0, node_size_, &tail_size_);
+        return const_iterator(nullptr, 0, node_size_, &tail_size_, &tail_);
     }
 
     const_iterator begin() const noexcept {
@@ -342,26 +806,29 @@ class ArrayLinkedList {
         return cend();
     }
 
-    reverse_iterator rbegin() noexcept {
-        return reverse_iterator(tail_, tail_size_ - 1, node_size_, &tail_size_);
+    reverse_iterator rbegin() {
+        detach();
+        return reverse_iterator(tail_, tail_size_ - 1, node_size_, &tail_size_, &tail_);
     }
 
     reverse_iterator rend() noexcept {
-        return reverse_iterator(nullptr, node_size_ - 1, node_size_, &tail_size_);
+        return reverse_iterator(nullptr, node_size_ - 1, node_size_, &tail_size_, &tail_);
     }
 
     const_reverse_iterator crbegin() const noexcept {
-        return const_reverse_iterator(tail_, tail_size_ - 1, node_size_, &tail_size_);
+        return const_reverse_iterator(tail_, tail_size_ - 1, node_size_, &tail_size_, &tail_);
     }
 
     const_reverse_iterator crend() const noexcept {
-        return const_reverse_iterator(nullptr, node_size_ - 1, node_size_, &tail_size_);
+        return const_reverse_iterator(nullptr, node_size_ - 1, node_size_, &tail_size_, &tail_);
     }
 
    private:
     T& get_item_at_index(size_t index) const {
+        ARRAY_LINKED_LIST_TRACE_SCOPE(GetItemAtIndex);
         if (index < size()) {
             size_t node_number = index / node_size_;
+            ARRAY_LINKED_LIST_TRACE_NODES(node_number);
 
             Node* it = head_;
             for (size_t i = 0; i < node_number; ++i)
@@ -375,6 +842,7 @@ class ArrayLinkedList {
 
    public:
     T& at(size_t index) {
+        detach();
         return get_item_at_index(index);
     }
 
@@ -390,8 +858,11 @@ class ArrayLinkedList {
     Returns a node pointer and the index of the key in the given node
     */
     std::pair<Node*, size_t> find_key(const T& key) const {
-        for (Node* it = head_; it != nullptr; it = it->next) {
-            size_t size = it->next == nullptr ? tail_size_ : node_size_;
+        ARRAY_LINKED_LIST_TRACE_SCOPE(FindKey);
+        for (Node* it = head_; it != nullptr; it = next_node(it)) {
+            ARRAY_LINKED_LIST_TRACE_NODES(1);
+            prefetch_following(it, tail_, node_size_);
+            size_t size = it == tail_ ? tail_size_ : node_size_;
             for (size_t i = 0; i < size; ++i) {
                 if (it->keys[i] == key)
                     return std::make_pair(it, i);
@@ -404,40 +875,140 @@ class ArrayLinkedList {
    public:
     const_iterator find(const T& key) const {
         auto [node, index] = find_key(key);
-        return const_iterator(node, index, node_size_, &tail_size_);
+        return const_iterator(node, index, node_size_, &tail_size_, &tail_);
     }
 
     iterator find(const T& key) {
+        detach();
         auto [node, index] = find_key(key);
-        return iterator(node, index, node_size_, &tail_size_);
+        return iterator(node, index, node_size_, &tail_size_, &tail_);
     }
 
     bool contains(const T& key) const {
         return find(key) != end();
     }
 
-    // resize / clear
+   private:
+    /*
+    Implementation of logic for searching many keys at once, for use with different iterator types.
+    Streams through the list once and calls found(key_index, node, index) the first time an item equal to keys[key_index] is found.
+    Each item is compared against a small block of keys without branching, so the comparisons can be vectorized,
+    or looked up in a hash map of the keys for larger batches (if T can be hashed)
+    */
+    template <typename Function>
+    void find_many_template(const std::vector<T>& keys, Function found) const {
+        size_t remaining = keys.size();
+        if (remaining == 0)
+            return;
+
+        if constexpr (std::is_default_constructible_v<std::hash<T>>) {
+            if (keys.size() > s_probe_block_size_) {
+                std::unordered_map<T, std::vector<size_t>> key_indices;
+                for (size_t i = 0; i < keys.size(); ++i)
+                    key_indices[keys[i]].push_back(i);
+
+                for (Node* it = head_; it != nullptr; it = next_node(it)) {
+                    prefetch_following(it, tail_, node_size_);
+                    size_t size = it == tail_ ? tail_size_ : node_size_;
+                    for (size_t i = 0; i < size; ++i) {
+                        auto match = key_indices.find(it->keys[i]);
+                        if (match == key_indices.end())
+                            continue;
+
+                        for (size_t key_index : match->second)
+                            found(key_index, it, i);
+                        remaining -= match->second.size();
+                        key_indices.erase(match);
+                        if (remaining == 0)
+                            return;
+                    }
+                }
+                return;
+            }
+        }
 
-    void resize(size_t new_size, const T& fill_item = T()) {
-	    if (new_size < size()) {
-            while (size()  > new_size) {
-                if (size() - tail_size_ >= new_size) {
-                    remove_last_node();
-                } else {
-                    size_t size_difference = size() - new_size;
-                    tail_size_ -= size_difference;
+        std::vector<bool> done(keys.size(), false);
+        for (Node* it = head_; it != nullptr; it = next_node(it)) {
+            prefetch_following(it, tail_, node_size_);
+            size_t size = it == tail_ ? tail_size_ : node_size_;
+            for (size_t i = 0; i < size; ++i) {
+                bool any_match = false;
+                for (size_t k = 0; k < keys.size(); ++k)
+                    any_match |= keys[k] == it->keys[i];
+
+                if (!any_match)
+                    continue;
+
+                for (size_t k = 0; k < keys.size(); ++k) {
+                    if (!done[k] && keys[k] == it->keys[i]) {
+                        done[k] = true;
+                        found(k, it, i);
+                        --remaining;
+                    }
                 }
+                if (remaining == 0)
+                    return;
+            }
+        }
+    }
+
+   public:
+    // Returns an iterator to the first item equal to each of the given keys (or end() if there is none) in the order of the keys
+    std::vector<const_iterator> find_many(const std::vector<T>& keys) const {
+        std::vector<const_iterator> result(keys.size(), cend());
+        find_many_template(keys, [&](size_t key_index, Node* node, size_t index) {
+            result[key_index] = const_iterator(node, index, node_size_, &tail_size_, &tail_);
+        });
+        return result;
+    }
+
+    std::vector<iterator> find_many(const std::vector<T>& keys) {
+        detach();
+        std::vector<iterator> result(keys.size(), end());
+        find_many_template(keys, [&](size_t key_index, Node* node, size_t index) {
+            result[key_index] = iterator(node, index, node_size_, &tail_size_, &tail_);
+        });
+        return result;
+    }
+
+    // Returns a bitmap in the order of the given keys, which contains true for every key contained in this list
+    std::vector<bool> contains_many(const std::vector<T>& keys) const {
+        std::vector<bool> result(keys.size(), false);
+        find_many_template(keys, [&](size_t key_index, Node*, size_t) {
+            result[key_index] = true;
+        });
+        return result;
+    }
+
+    // resize / clear
+
+   private:
+    // Removes items from the back until the list has the given size, freeing every node that becomes empty
+    void shrink(size_t new_size) {
+        while (size() > new_size) {
+            if (size() - tail_size_ >= new_size) {
+                remove_last_node();
+            } else {
+                size_t size_difference = size() - new_size;
+                tail_size_ -= size_difference;
             }
+        }
+    }
+
+   public:
+    void resize(size_t new_size, const T& fill_item = T()) {
+        if (new_size < size()) {
+            detach();
+            shrink(new_size);
         } else {
-            while (size() < new_size) {
-                if (tail_size_ == node_size_) {
-                    tail_->next = new Node(node_size_, tail_);
-                    tail_ = tail_->next;
-                    ++node_count_;
-                    tail_size_ = 0;
-                }
-                tail_->keys[tail_size_] = fill_item;
-                ++tail_size_;
+            // The list is shrunk back to its old size if a copy of fill_item throws
+            size_t old_size = size();
+            try {
+                while (size() < new_size)
+                    push_back(fill_item);
+            } catch (...) {
+                shrink(old_size);
+                throw;
             }
         }
     }
@@ -445,6 +1016,8 @@ class ArrayLinkedList {
     void clear() {
         _free();
         head_ = tail_ = nullptr;
+        node_count_ = 0;
+        tail_size_ = 0;
     }
 
     // Functions that add items
@@ -456,18 +1029,32 @@ class ArrayLinkedList {
     */
     template <typename Function>
     void push_back_template(Function func) {
+        ARRAY_LINKED_LIST_TRACE_SCOPE(PushBack);
+        detach_for_append();
+        bool appended = true;
         if (head_ == nullptr) {
-            head_ = tail_ = new Node(node_size_);
-            node_count_ = 1;
-            func(head_);
+            if constexpr (InlineCapacity > 0) {
+                head_ = tail_ = inline_node();
+                node_count_ = 1;
+            } else {
+                append_node();
+            }
+        } else if (is_inline(tail_) && tail_size_ == inline_capacity()) {
+            spill_inline_node(func);
+            return;
         } else if (tail_size_ < node_size_) {
-            func(tail_);
+            appended = false;
         } else {
-            tail_->next = new Node(node_size_, tail_);
-            ++node_count_;
-            tail_ = tail_->next;
-            tail_size_ = 0;
+            append_node();
+        }
+
+        // A node that was appended for the key is removed again if the key cannot be inserted, so no empty node is left behind
+        try {
             func(tail_);
+        } catch (...) {
+            if (appended)
+                remove_last_node();
+            throw;
         }
     }
 
@@ -494,12 +1081,21 @@ class ArrayLinkedList {
             ++tail_size_;
         });
 
-        return back();
+        // The new item is not visible to other lists sharing the nodes, so unlike back() this does not need to detach
+        return tail_->keys[tail_size_ - 1];
     }
 
    private:
 
     void remove_last_node() {
+        ARRAY_LINKED_LIST_TRACE_SCOPE(RemoveLastNode);
+        if (is_inline(tail_)) {
+            head_ = tail_ = nullptr;
+            tail_size_ = 0;
+            --node_count_;
+            return;
+        }
+
         Node* prev_tail = tail_;
         tail_ = tail_->prev;
         if (tail_ == nullptr) {
@@ -509,7 +1105,7 @@ class ArrayLinkedList {
             tail_->next = nullptr;
             tail_size_ = node_size_;
         }
-        delete prev_tail;
+        delete_node(prev_tail);
         --node_count_;
     }
 
@@ -518,6 +1114,7 @@ class ArrayLinkedList {
    public:
 
     void pop_back() {
+        detach();
         if (tail_size_ > 1) {
             --tail_size_;
         }
@@ -529,8 +1126,13 @@ class ArrayLinkedList {
    private:
     // Shifts every item in this array from the start_index up to size shift_distance places forward
     static void shift_forward(T* arr, size_t start_index, size_t size, size_t shift_distance) {
-        for (size_t i = start_index; i < size; ++i)
-            arr[i - shift_distance] = std::move(arr[i]);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (start_index < size)
+                std::memmove(arr + start_index - shift_distance, arr + start_index, (size - start_index) * sizeof(T));
+        } else {
+            for (size_t i = start_index; i < size; ++i)
+                arr[i - shift_distance] = move_or_copy(arr[i]);
+        }
     }
 
     /*
@@ -539,14 +1141,20 @@ class ArrayLinkedList {
     */
     template <typename ItType>
     ItType erase_template(ItType pos, ItType end) {
+        ARRAY_LINKED_LIST_TRACE_SCOPE(Erase);
+        detach(pos, end);
         size_t start_node_size = pos.current_node_->next == nullptr ? tail_size_ : node_size_;
         shift_forward(pos.current_node_->keys, pos.index_ + 1, start_node_size, 1);
+        ARRAY_LINKED_LIST_TRACE_NODES(1);
+        ARRAY_LINKED_LIST_TRACE_SHIFTED(start_node_size - pos.index_ - 1);
 
         Node* it = pos.current_node_;
         while (it->next != nullptr) {
-            it->keys[node_size_ - 1] = std::move(it->next->keys[0]);
+            it->keys[node_size_ - 1] = move_or_copy(it->next->keys[0]);
             size_t keys_size = it->next->next == nullptr ? tail_size_ : node_size_;
             shift_forward(it->next->keys, 1, keys_size, 1);
+            ARRAY_LINKED_LIST_TRACE_NODES(1);
+            ARRAY_LINKED_LIST_TRACE_SHIFTED(keys_size);
 
             it = it->next;
         }
@@ -574,4 +1182,238 @@ class ArrayLinkedList {
     const_iterator erase(const_iterator pos) {
         return erase_template(pos, cend());
     }
+
+   private:
+    /*
+    Moves every item from read to the end of the list that does not match the predicate to the position of write and
+    advances write past it, then removes the items left over behind write. This compacts the whole list in one pass.
+    removed is the number of items between write and read when this is called. Returns the total number of removed items
+    */
+    template <typename Predicate>
+    size_t compact(iterator write, iterator read, size_t removed, Predicate pred) {
+        iterator end_it = end();
+        for (; read != end_it; ++read) {
+            if (pred(*read)) {
+                ++removed;
+            } else {
+                if (removed != 0)
+                    *write = move_or_copy(*read);
+                ++write;
+            }
+        }
+
+        shrink(size() - removed);
+        return removed;
+    }
+
+    /*
+    Implements logic for deleting a range of items. This abstracts from the returned and passed iterator type in order to
+    not implement the same logic twice
+    */
+    template <typename ItType>
+    ItType erase_range_template(ItType first, ItType last, ItType end) {
+        if (first == last)
+            return last;
+        detach(first, last);
+
+        iterator write(first.current_node_, first.index_, node_size_, &tail_size_, &tail_);
+        iterator read = write;
+        size_t removed = 0;
+        for (; read != last; ++read)
+            ++removed;
+
+        // If nothing follows the erased range, first will be past the end of the list after the compaction
+        bool return_end = last == end;
+        compact(write, read, removed, [](const T&) {
+            return false;
+        });
+
+        if (return_end)
+            return end;
+        return first;
+    }
+
+   public:
+
+    // removes the items in [first, last) and returns an iterator pointing to the item following the removed items
+    iterator erase(iterator first, iterator last) {
+        return erase_range_template(first, last, end());
+    }
+
+    const_iterator erase(const_iterator first, const_iterator last) {
+        return erase_range_template(first, last, cend());
+    }
+
+    // removes every item the predicate returns true for and returns the number of removed items
+    template <typename Predicate>
+    size_t erase_if(Predicate pred) {
+        return compact(begin(), begin(), 0, pred);
+    }
+
+    // removes every item equal to the given key and returns the number of removed items
+    size_t remove(const T& key) {
+        // The key is copied, because it may refer to an item of this list that is overwritten during the compaction
+        T key_copy = key;
+        return erase_if([&](const T& item) {
+            return item == key_copy;
+        });
+    }
+
+    // Binary serialization (only available for trivially copyable types)
+
+   private:
+    static const uint64_t s_serialization_magic_ = 0x4c4c4b4e4c525241; // "ARRLNKLL"
+
+    // Written in the byte order of the machine, so data written on a machine with the other byte order is recognized
+    static const uint64_t s_byte_order_marker_ = 0x0102030405060708;
+    static const uint64_t s_swapped_byte_order_marker_ = 0x0807060504030201;
+
+    /*
+    Describes the element type by its size, alignment and category, so data written for a different type of the same size
+    (e.g. float for int) is rejected. Trivially copyable class types with equal size and alignment cannot be told apart
+    */
+    static constexpr uint64_t serialized_type_tag() {
+        return static_cast<uint64_t>(sizeof(T)) << 32
+            | static_cast<uint64_t>(alignof(T)) << 16
+            | static_cast<uint64_t>(std::is_integral_v<T>) << 0
+            | static_cast<uint64_t>(std::is_floating_point_v<T>) << 1
+            | static_cast<uint64_t>(std::is_signed_v<T>) << 2
+            | static_cast<uint64_t>(std::is_enum_v<T>) << 3
+            | static_cast<uint64_t>(std::is_pointer_v<T>) << 4
+            | static_cast<uint64_t>(std::is_class_v<T> || std::is_union_v<T>) << 5
+            | static_cast<uint64_t>(std::is_array_v<T>) << 6;
+    }
+
+    /*
+    The serialized format is this header followed by the keys of all nodes in order. As every node but the tail is full,
+    the keys form one contiguous array of count elements directly after the header.
+    The header is padded to 64 bytes, so in a buffer aligned to 64 bytes (e.g. a memory mapped file) the keys are aligned
+    for every type with an alignment of up to 64 bytes
+    */
+    struct SerializedHeader {
+        uint64_t magic;
+        uint64_t byte_order;
+        uint64_t node_size;
+        uint64_t count;
+        uint64_t type_tag;
+        uint64_t reserved[3];
+    };
+    static_assert(sizeof(SerializedHeader) == 64, "The serialized keys have to start 64 bytes into the data");
+
+    static SerializedHeader check_header(const SerializedHeader& header) {
+        if (header.magic != s_serialization_magic_)
+            throw std::runtime_error("Invalid ArrayLinkedList serialization header");
+        if (header.byte_order == s_swapped_byte_order_marker_)
+            throw std::runtime_error("Serialized ArrayLinkedList was written with a different byte order");
+        if (header.byte_order != s_byte_order_marker_)
+            throw std::runtime_error("Invalid ArrayLinkedList serialization header");
+        if (header.type_tag != serialized_type_tag())
+            throw std::runtime_error("Serialized ArrayLinkedList has a different element type");
+        if (header.node_size == 0)
+            throw std::runtime_error("Serialized ArrayLinkedList has a node size of 0");
+        return header;
+    }
+
+   public:
+    /*
+    Read-only view over a serialized list in memory (e.g. a memory mapped file). The view does not copy the keys
+    and does not own the memory, so the memory has to outlive it
+    */
+    class SerializedView {
+        friend class ArrayLinkedList<T, Allocator, InlineCapacity>;
+
+        const T* keys_;
+        size_t size_;
+        size_t node_size_;
+
+        SerializedView(const T* keys, size_t size, size_t node_size) :
+            keys_(keys),
+            size_(size),
+            node_size_(node_size) {}
+
+       public:
+        using value_type = T;
+        using const_iterator = const T*;
+
+        size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        size_t node_size() const {
+            return node_size_;
+        }
+
+        const T& at(size_t index) const {
+            if (index < size_)
+                return keys_[index];
+            else
+                throw std::runtime_error("Index out of bounds");
+        }
+
+        const_iterator begin() const {
+            return keys_;
+        }
+
+        const_iterator end() const {
+            return keys_ + size_;
+        }
+    };
+
+    void serialize(std::ostream& out) const {
+        static_assert(std::is_trivially_copyable_v<T>, "Only lists of trivially copyable types can be serialized");
+        SerializedHeader header = {s_serialization_magic_, s_byte_order_marker_, node_size_, size(), serialized_type_tag(), {}};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (Node* it = head_; it != nullptr; it = next_node(it)) {
+            size_t keys_size = it == tail_ ? tail_size_ : node_size_;
+            out.write(reinterpret_cast<const char*>(it->keys), keys_size * sizeof(T));
+        }
+
+        if (!out)
+            throw std::runtime_error("Failed to write ArrayLinkedList");
+    }
+
+    // Reads a list written by serialize(), reading the keys of each node in one block
+    static ArrayLinkedList<T, Allocator, InlineCapacity> deserialize(std::istream& in, const Allocator& allocator = Allocator()) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only lists of trivially copyable types can be deserialized");
+        SerializedHeader header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            throw std::runtime_error("Failed to read ArrayLinkedList header");
+        check_header(header);
+
+        ArrayLinkedList<T, Allocator, InlineCapacity> result(header.node_size, allocator);
+        size_t remaining = header.count;
+        while (remaining > 0) {
+            size_t block_size = remaining < result.node_size_ ? remaining : result.node_size_;
+            result.append_node();
+            if (!in.read(reinterpret_cast<char*>(result.tail_->keys), block_size * sizeof(T)))
+                throw std::runtime_error("Failed to read ArrayLinkedList keys");
+            result.tail_size_ = block_size;
+            remaining -= block_size;
+        }
+
+        return result;
+    }
+
+    // Creates a view over data written by serialize() without copying the keys
+    static SerializedView view(const void* data, size_t length) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only lists of trivially copyable types can be viewed");
+        SerializedHeader header;
+        if (length < sizeof(header))
+            throw std::runtime_error("Buffer too small for ArrayLinkedList header");
+        std::memcpy(&header, data, sizeof(header));
+        check_header(header);
+
+        const char* keys = static_cast<const char*>(data) + sizeof(header);
+        if (header.count > (length - sizeof(header)) / sizeof(T))
+            throw std::runtime_error("Buffer too small for serialized ArrayLinkedList");
+        if (reinterpret_cast<uintptr_t>(keys) % alignof(T) != 0)
+            throw std::runtime_error("Serialized ArrayLinkedList keys are not aligned");
+
+        return SerializedView(reinterpret_cast<const T*>(keys), header.count, header.node_size);
+    }
 };
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define ARRAY_LINKED_LIST_STREAM_COROUTINES
+#endif
+
+#include "ArrayLinkedList.h"
+
+/*
+Hands the keys of a producer to a consumer node by node, so the consumer can start working while the producer is still
+filling the list. Keys pushed by the producer are collected in a segment (an ArrayLinkedList with a single node), which is
+passed on as soon as it is full, or when the stream is closed. If max_pending_segments is not 0, the producer blocks while
+that many segments are waiting to be consumed (backpressure).
+push() and close() must only be called by one thread at a time. Consumers can either block in next_segment() or,
+when compiled as C++20, co_await next_segment_async(), in which case the awaiting coroutine is resumed on the producer thread.
+C++20 builds also provide spans(), a generator that yields the keys of each segment as a contiguous span
+*/
+template <typename T>
+class ArrayLinkedListStream {
+    using Segment = ArrayLinkedList<T>;
+
+    static const size_t s_default_node_size_ = 50;
+
+#ifdef ARRAY_LINKED_LIST_STREAM_COROUTINES
+   public:
+    class SegmentAwaiter;
+
+   private:
+    std::deque<SegmentAwaiter*> waiting_coroutines_;
+#endif
+
+    std::mutex mutex_;
+    std::condition_variable segment_ready_;
+    std::condition_variable space_ready_;
+    std::deque<Segment> pending_;
+
+    // Only accessed by the producer
+    Segment filling_;
+
+    size_t node_size_;
+    size_t max_pending_segments_;
+    bool closed_;
+
+    // Passes the filled segment on to a waiting coroutine or the pending segments
+    void seal() {
+        Segment segment(std::move(filling_));
+        filling_ = Segment(node_size_);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+#ifdef ARRAY_LINKED_LIST_STREAM_COROUTINES
+        if (!waiting_coroutines_.empty()) {
+            SegmentAwaiter* awaiter = waiting_coroutines_.front();
+            waiting_coroutines_.pop_front();
+            lock.unlock();
+
+            awaiter->result_ = std::move(segment);
+            awaiter->handle_.resume();
+            return;
+        }
+#endif
+        space_ready_.wait(lock, [&]() {
+            return max_pending_segments_ == 0 || pending_.size() < max_pending_segments_;
+        });
+        pending_.push_back(std::move(segment));
+        lock.unlock();
+        segment_ready_.notify_one();
+    }
+
+    // Takes the next pending segment, must be called with the mutex held
+    std::optional<Segment> take_pending() {
+        if (pending_.empty())
+            return std::nullopt;
+
+        std::optional<Segment> result(std::move(pending_.front()));
+        pending_.pop_front();
+        space_ready_.notify_one();
+        return result;
+    }
+
+   public:
+    using value_type = T;
+
+    explicit ArrayLinkedListStream(size_t node_size = s_default_node_size_, size_t max_pending_segments = 0) :
+        filling_(node_size),
+        node_size_(node_size),
+        max_pending_segments_(max_pending_segments),
+        closed_(false) {}
+
+    ArrayLinkedListStream(const ArrayLinkedListStream<T>& other) = delete;
+    ArrayLinkedListStream<T>& operator=(const ArrayLinkedListStream<T>& other) = delete;
+
+    size_t node_size() const {
+        return node_size_;
+    }
+
+    // Producer functions
+
+    void push(const T& key) {
+        filling_.push_back(key);
+        if (filling_.size() == node_size_)
+            seal();
+    }
+
+    void push(T&& key) {
+        filling_.push_back(std::move(key));
+        if (filling_.size() == node_size_)
+            seal();
+    }
+
+    // Passes on the partially filled segment and wakes up all consumers that are waiting for segments that will never come
+    void close() {
+        if (!filling_.empty())
+            seal();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        closed_ = true;
+#ifdef ARRAY_LINKED_LIST_STREAM_COROUTINES
+        std::deque<SegmentAwaiter*> waiting = std::move(waiting_coroutines_);
+        waiting_coroutines_.clear();
+        lock.unlock();
+        for (SegmentAwaiter* awaiter : waiting)
+            awaiter->handle_.resume();
+#else
+        lock.unlock();
+#endif
+        segment_ready_.notify_all();
+    }
+
+    // Consumer functions
+
+    // Blocks until the next segment is available, returns std::nullopt once the stream is closed and all segments were consumed
+    std::optional<Segment> next_segment() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        segment_ready_.wait(lock, [&]() {
+            return !pending_.empty() || closed_;
+        });
+        return take_pending();
+    }
+
+#ifdef ARRAY_LINKED_LIST_STREAM_COROUTINES
+    class SegmentAwaiter {
+        friend class ArrayLinkedListStream<T>;
+
+        ArrayLinkedListStream<T>* stream_;
+        std::coroutine_handle<> handle_;
+        std::optional<Segment> result_;
+
+        explicit SegmentAwaiter(ArrayLinkedListStream<T>* stream) :
+            stream_(stream) {}
+
+       public:
+        bool await_ready() {
+            return false;
+        }
+
+        // Only suspends if there is no pending segment and the stream is still open
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(stream_->mutex_);
+            if (!stream_->pending_.empty() || stream_->closed_) {
+                result_ = stream_->take_pending();
+                return false;
+            }
+
+            handle_ = handle;
+            stream_->waiting_coroutines_.push_back(this);
+            return true;
+        }
+
+        std::optional<Segment> await_resume() {
+            return std::move(result_);
+        }
+    };
+
+    // Awaitable version of next_segment()
+    SegmentAwaiter next_segment_async() {
+        return SegmentAwaiter(this);
+    }
+
+    // Contiguous keys of a single segment
+    class SegmentSpan {
+        const T* data_;
+        size_t size_;
+
+       public:
+        SegmentSpan(const T* data, size_t size) :
+            data_(data),
+            size_(size) {}
+
+        const T* data() const {
+            return data_;
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        const T* begin() const {
+            return data_;
+        }
+
+        const T* end() const {
+            return data_ + size_;
+        }
+    };
+
+    /*
+    Generator returned by spans(). Advancing it blocks like next_segment(), and a span is only valid until the generator
+    is advanced again, because the segment holding its keys is released then
+    */
+    class SpanGenerator {
+       public:
+        class promise_type {
+            friend class SpanGenerator;
+
+            const SegmentSpan* current_ = nullptr;
+            std::exception_ptr exception_;
+
+           public:
+            SpanGenerator get_return_object() {
+                return SpanGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always yield_value(const SegmentSpan& span) noexcept {
+                current_ = &span;
+                return {};
+            }
+
+            void return_void() {}
+
+            void unhandled_exception() {
+                exception_ = std::current_exception();
+            }
+        };
+
+        class iterator {
+            friend class SpanGenerator;
+
+            std::coroutine_handle<promise_type> handle_;
+
+            explicit iterator(std::coroutine_handle<promise_type> handle) :
+                handle_(handle) {}
+
+           public:
+            using value_type = SegmentSpan;
+
+            iterator& operator++() {
+                resume(handle_);
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const {
+                return handle_ == other.handle_;
+            }
+
+            bool operator!=(const iterator& other) const {
+                return !(*this == other);
+            }
+
+            const SegmentSpan& operator*() const {
+                return *handle_.promise().current_;
+            }
+
+            const SegmentSpan* operator->() const {
+                return handle_.promise().current_;
+            }
+        };
+
+       private:
+        std::coroutine_handle<promise_type> handle_;
+
+        explicit SpanGenerator(std::coroutine_handle<promise_type> handle) :
+            handle_(handle) {}
+
+        // Runs the coroutine up to the next span and turns the handle into the end iterator once it is finished
+        static void resume(std::coroutine_handle<promise_type>& handle) {
+            handle.resume();
+            if (handle.done()) {
+                std::exception_ptr exception = handle.promise().exception_;
+                handle = nullptr;
+                if (exception)
+                    std::rethrow_exception(exception);
+            }
+        }
+
+       public:
+        SpanGenerator(const SpanGenerator& other) = delete;
+        SpanGenerator& operator=(const SpanGenerator& other) = delete;
+
+        SpanGenerator(SpanGenerator&& other) noexcept :
+            handle_(other.handle_) {
+            other.handle_ = nullptr;
+        }
+
+        ~SpanGenerator() {
+            if (handle_)
+                handle_.destroy();
+        }
+
+        // Can only be called once, as the generator is consumed while iterating
+        iterator begin() {
+            std::coroutine_handle<promise_type> handle = handle_;
+            resume(handle);
+            return iterator(handle);
+        }
+
+        iterator end() {
+            return iterator(nullptr);
+        }
+    };
+
+    // Generator over the keys of all segments, which ends once the stream is closed and all segments were consumed
+    SpanGenerator spans() {
+        while (std::optional<Segment> segment = next_segment()) {
+            const Segment& keys = *segment;
+            co_yield SegmentSpan(&*keys.cbegin(), keys.size());
+        }
+    }
+#endif
+};
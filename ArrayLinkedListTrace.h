@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+Instrumentation for ArrayLinkedList, which is only compiled in if ARRAY_LINKED_LIST_TRACING is defined before
+ArrayLinkedList.h is included (for all translation units of a program). Every traced operation records how often it
+was called, how many nodes it traversed, how many keys it shifted and its latency in cycles (or nanoseconds on platforms
+without a cycle counter). The statistics are kept per thread, so recording them does not need any synchronisation
+*/
+enum class TraceOperation {
+    PushBack,
+    RemoveLastNode,
+    Erase,
+    GetItemAtIndex,
+    FindKey,
+    Count
+};
+
+inline const char* trace_operation_name(TraceOperation operation) {
+    switch (operation) {
+        case TraceOperation::PushBack:
+            return "push_back";
+        case TraceOperation::RemoveLastNode:
+            return "remove_last_node";
+        case TraceOperation::Erase:
+            return "erase";
+        case TraceOperation::GetItemAtIndex:
+            return "get_item_at_index";
+        case TraceOperation::FindKey:
+            return "find_key";
+        default:
+            return "unknown";
+    }
+}
+
+/*
+Histogram with logarithmic buckets that are each divided into s_sub_buckets_ linear sub buckets (like an HDR histogram),
+so every recorded value is off by at most 1 / s_sub_buckets_ of its magnitude
+*/
+class LatencyHistogram {
+    static const size_t s_sub_bucket_bits_ = 3;
+    static const size_t s_sub_buckets_ = size_t(1) << s_sub_bucket_bits_;
+    static const size_t s_bucket_count_ = 64 * s_sub_buckets_;
+
+    std::array<uint64_t, s_bucket_count_> buckets_;
+    uint64_t count_;
+    uint64_t sum_;
+    uint64_t min_;
+    uint64_t max_;
+
+    static size_t highest_bit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<size_t>(__builtin_clzll(value));
+#else
+        size_t result = 0;
+        while (value >>= 1)
+            ++result;
+        return result;
+#endif
+    }
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < s_sub_buckets_)
+            return static_cast<size_t>(value);
+
+        size_t magnitude = highest_bit(value);
+        size_t sub_bucket = static_cast<size_t>(value >> (magnitude - s_sub_bucket_bits_)) & (s_sub_buckets_ - 1);
+        return (magnitude - s_sub_bucket_bits_ + 1) * s_sub_buckets_ + sub_bucket;
+    }
+
+    // Returns the smallest value that falls into the given bucket
+    static uint64_t bucket_value(size_t index) {
+        if (index < s_sub_buckets_)
+            return index;
+
+        size_t magnitude = index / s_sub_buckets_ + s_sub_bucket_bits_ - 1;
+        uint64_t sub_bucket = index % s_sub_buckets_;
+        return (uint64_t(1) << magnitude) | (sub_bucket << (magnitude - s_sub_bucket_bits_));
+    }
+
+   public:
+    LatencyHistogram() :
+        buckets_(),
+        count_(0),
+        sum_(0),
+        min_(UINT64_MAX),
+        max_(0) {}
+
+    void record(uint64_t value) {
+        ++buckets_[bucket_index(value)];
+        ++count_;
+        sum_ += value;
+        if (value < min_)
+            min_ = value;
+        if (value > max_)
+            max_ = value;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < s_bucket_count_; ++i)
+            buckets_[i] += other.buckets_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        if (other.min_ < min_)
+            min_ = other.min_;
+        if (other.max_ > max_)
+            max_ = other.max_;
+    }
+
+    uint64_t count() const {
+        return count_;
+    }
+
+    uint64_t min() const {
+        return count_ == 0 ? 0 : min_;
+    }
+
+    uint64_t max() const {
+        return max_;
+    }
+
+    double mean() const {
+        return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+    }
+
+    // Returns the lower bound of the bucket containing the given percentile (0 - 100)
+    uint64_t percentile(double percentile) const {
+        if (count_ == 0)
+            return 0;
+
+        uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count_ - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < s_bucket_count_; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank)
+                return bucket_value(i);
+        }
+        return max_;
+    }
+};
+
+class OperationStats {
+   public:
+    uint64_t count = 0;
+    uint64_t nodes_traversed = 0;
+    uint64_t elements_shifted = 0;
+    LatencyHistogram latency;
+
+    void merge(const OperationStats& other) {
+        count += other.count;
+        nodes_traversed += other.nodes_traversed;
+        elements_shifted += other.elements_shifted;
+        latency.merge(other.latency);
+    }
+};
+
+class TraceStats {
+    std::array<OperationStats, static_cast<size_t>(TraceOperation::Count)> operations_;
+
+   public:
+    OperationStats& operator[](TraceOperation operation) {
+        return operations_[static_cast<size_t>(operation)];
+    }
+
+    const OperationStats& operator[](TraceOperation operation) const {
+        return operations_[static_cast<size_t>(operation)];
+    }
+
+    void merge(const TraceStats& other) {
+        for (size_t i = 0; i < operations_.size(); ++i)
+            operations_[i].merge(other.operations_[i]);
+    }
+
+    void reset() {
+        operations_ = {};
+    }
+
+    std::string to_json() const {
+        std::ostringstream out;
+        out << "{";
+        for (size_t i = 0; i < operations_.size(); ++i) {
+            const OperationStats& stats = operations_[i];
+            out << (i == 0 ? "" : ",") << "\"" << trace_operation_name(static_cast<TraceOperation>(i)) << "\":{"
+                << "\"count\":" << stats.count
+                << ",\"nodes_traversed\":" << stats.nodes_traversed
+                << ",\"elements_shifted\":" << stats.elements_shifted
+                << ",\"latency\":{"
+                << "\"min\":" << stats.latency.min()
+                << ",\"mean\":" << stats.latency.mean()
+                << ",\"p50\":" << stats.latency.percentile(50)
+                << ",\"p99\":" << stats.latency.percentile(99)
+                << ",\"max\":" << stats.latency.max()
+                << "}}";
+        }
+        out << "}";
+        return out.str();
+    }
+
+    std::string to_text() const {
+        std::ostringstream out;
+        for (size_t i = 0; i < operations_.size(); ++i) {
+            const OperationStats& stats = operations_[i];
+            if (stats.count == 0)
+                continue;
+
+            double calls = static_cast<double>(stats.count);
+            out << trace_operation_name(static_cast<TraceOperation>(i)) << ": "
+                << stats.count << " calls, "
+                << static_cast<double>(stats.nodes_traversed) / calls << " nodes traversed / call, "
+                << static_cast<double>(stats.elements_shifted) / calls << " elements shifted / call, "
+                << "latency min " << stats.latency.min()
+                << " mean " << stats.latency.mean()
+                << " p50 " << stats.latency.percentile(50)
+                << " p99 " << stats.latency.percentile(99)
+                << " max " << stats.latency.max() << "\n";
+        }
+        return out.str();
+    }
+};
+
+// Returns the statistics of the calling thread
+inline TraceStats& thread_trace_stats() {
+    thread_local TraceStats stats;
+    return stats;
+}
+
+inline uint64_t trace_timestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Records a single call of an operation into the statistics of the calling thread when it goes out of scope
+class TraceScope {
+    TraceOperation operation_;
+    uint64_t start_;
+    uint64_t nodes_traversed_;
+    uint64_t elements_shifted_;
+
+   public:
+    explicit TraceScope(TraceOperation operation) :
+        operation_(operation),
+        start_(trace_timestamp()),
+        nodes_traversed_(0),
+        elements_shifted_(0) {}
+
+    TraceScope(const TraceScope& other) = delete;
+    TraceScope& operator=(const TraceScope& other) = delete;
+
+    ~TraceScope() {
+        uint64_t end = trace_timestamp();
+        OperationStats& stats = thread_trace_stats()[operation_];
+        ++stats.count;
+        stats.nodes_traversed += nodes_traversed_;
+        stats.elements_shifted += elements_shifted_;
+        stats.latency.record(end - start_);
+    }
+
+    void add_nodes(uint64_t count) {
+        nodes_traversed_ += count;
+    }
+
+    void add_shifted(uint64_t count) {
+        elements_shifted_ += count;
+    }
+};
@@ -0,0 +1,613 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ArrayLinkedList.h"
+
+// Decoding uses SSE2 (and AVX2 if enabled for the build) unless COMPRESSED_ARRAY_LINKED_LIST_NO_SIMD is defined
+#if !defined(COMPRESSED_ARRAY_LINKED_LIST_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define COMPRESSED_ARRAY_LINKED_LIST_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define COMPRESSED_ARRAY_LINKED_LIST_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+/*
+Variant of ArrayLinkedList for unsigned integers (e.g. ids or timestamps) that stores every full node bit-packed.
+Only the tail node holds plain keys, so push_back stays cheap, and the tail is compressed when it seals (becomes full).
+Keys of a node that never decrease are stored as deltas to their predecessor, all other nodes are stored relative to their
+smallest key (frame of reference). Either way each key only takes as many bits as the largest stored value needs.
+Every node also keeps its smallest and largest key, so find can skip nodes that cannot contain the key without decoding them.
+The packed keys are interleaved over s_lanes_ lanes: key i is stored in lane i % s_lanes_, and every lane is a separate
+stream of bits whose words are interleaved with the words of the other lanes. The keys s_lanes_ * p to s_lanes_ * p + s_lanes_ - 1
+are then found at the same word offset and shift in every lane, so they are unpacked together with a few vector shifts.
+Keys are read only, changing a key would require recompressing its node
+*/
+template <typename T>
+class CompressedArrayLinkedList {
+    static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "CompressedArrayLinkedList only supports unsigned integer keys");
+
+    static const size_t s_default_node_size_ = 128;
+    static const size_t s_word_bits_ = 64;
+    static const size_t s_lanes_ = 4;
+
+    class Node {
+       public:
+        uint64_t* words;
+        T min;
+        T max;
+        uint8_t bit_width;
+        bool delta_encoded;
+
+        Node* next;
+        Node* prev;
+
+        Node(size_t word_count, Node* prev = nullptr) :
+            words(word_count == 0 ? nullptr : new uint64_t[word_count]()),
+            min(0),
+            max(0),
+            bit_width(0),
+            delta_encoded(false),
+            next(nullptr),
+            prev(prev) {}
+
+        ~Node() {
+            delete[] words;
+        }
+    };
+
+    Node* head_;
+    Node* tail_;
+
+    // Plain keys of the node that is currently filled, it is never empty unless the list is empty
+    T* tail_keys_;
+
+    size_t node_size_;
+    size_t node_count_;
+    size_t tail_size_;
+
+    // Utility for packing and unpacking
+
+    // Every lane takes the same number of words, which is enough for the first lane (the only one that can be longer)
+    static size_t word_count(size_t node_size, uint8_t bit_width) {
+        size_t lane_keys = (node_size + s_lanes_ - 1) / s_lanes_;
+        return (lane_keys * bit_width + s_word_bits_ - 1) / s_word_bits_ * s_lanes_;
+    }
+
+    static uint64_t bit_mask(uint8_t bit_width) {
+        return bit_width == s_word_bits_ ? ~uint64_t(0) : (uint64_t(1) << bit_width) - 1;
+    }
+
+    // Returns the index of the word holding the first bit of the given key, and the position of that bit in the word
+    static std::pair<size_t, size_t> bit_position(size_t index, uint8_t bit_width) {
+        size_t bit = index / s_lanes_ * bit_width;
+        return {bit / s_word_bits_ * s_lanes_ + index % s_lanes_, bit % s_word_bits_};
+    }
+
+    static uint8_t bits_needed(uint64_t value) {
+        uint8_t result = 0;
+        while (value != 0) {
+            ++result;
+            value >>= 1;
+        }
+        return result;
+    }
+
+    static uint64_t unpack(const uint64_t* words, size_t index, uint8_t bit_width) {
+        if (bit_width == 0)
+            return 0;
+
+        auto [word, shift] = bit_position(index, bit_width);
+        uint64_t value = words[word] >> shift;
+        if (shift + bit_width > s_word_bits_)
+            value |= words[word + s_lanes_] << (s_word_bits_ - shift);
+        return value & bit_mask(bit_width);
+    }
+
+    /*
+    Unpacks one key from each lane, which are at the same position in all lanes. The words holding the keys start at row,
+    and keys crossing a word boundary continue in the words at next. If no key crosses a word boundary, next is row
+    and next_shift is 64, which vector shifts turn into 0
+    */
+    static void unpack_row(const uint64_t* row, const uint64_t* next, size_t shift, size_t next_shift, uint64_t mask, T* keys) {
+#if defined(COMPRESSED_ARRAY_LINKED_LIST_AVX2)
+        __m256i values = _mm256_or_si256(
+            _mm256_srl_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row)), _mm_cvtsi32_si128(static_cast<int>(shift))),
+            _mm256_sll_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(next)), _mm_cvtsi32_si128(static_cast<int>(next_shift))));
+        values = _mm256_and_si256(values, _mm256_set1_epi64x(static_cast<long long>(mask)));
+        if constexpr (sizeof(T) == 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys), values);
+            return;
+        } else if constexpr (sizeof(T) == 4) {
+            values = _mm256_permutevar8x32_epi32(values, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keys), _mm256_castsi256_si128(values));
+            return;
+        }
+#elif defined(COMPRESSED_ARRAY_LINKED_LIST_SSE2)
+        __m128i right = _mm_cvtsi32_si128(static_cast<int>(shift));
+        __m128i left = _mm_cvtsi32_si128(static_cast<int>(next_shift));
+        __m128i vector_mask = _mm_set1_epi64x(static_cast<long long>(mask));
+        __m128i low = _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row)), right),
+            _mm_sll_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(next)), left));
+        __m128i high = _mm_or_si128(_mm_srl_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + 2)), right),
+            _mm_sll_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(next + 2)), left));
+        low = _mm_and_si128(low, vector_mask);
+        high = _mm_and_si128(high, vector_mask);
+        if constexpr (sizeof(T) == 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keys), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keys + 2), high);
+            return;
+        } else if constexpr (sizeof(T) == 4) {
+            // Moves the low halves of the 64 bit values next to each other
+            low = _mm_shuffle_epi32(low, _MM_SHUFFLE(3, 1, 2, 0));
+            high = _mm_shuffle_epi32(high, _MM_SHUFFLE(3, 1, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(keys), _mm_unpacklo_epi64(low, high));
+            return;
+        }
+#endif
+        for (size_t lane = 0; lane < s_lanes_; ++lane) {
+            uint64_t value = row[lane] >> shift;
+            if (next_shift < s_word_bits_)
+                value |= next[lane] << next_shift;
+            keys[lane] = static_cast<T>(value & mask);
+        }
+    }
+
+    // Unpacks the stored values of all keys of a node, without adding the base
+    void unpack_all(const uint64_t* words, uint8_t bit_width, T* out) const {
+        if (bit_width == 0) {
+            std::fill(out, out + node_size_, T(0));
+            return;
+        }
+
+        uint64_t mask = bit_mask(bit_width);
+        size_t rows = node_size_ / s_lanes_;
+        for (size_t row = 0; row < rows; ++row) {
+            auto [word, shift] = bit_position(row * s_lanes_, bit_width);
+            bool crossing = shift + bit_width > s_word_bits_;
+            unpack_row(words + word, crossing ? words + word + s_lanes_ : words + word, shift,
+                crossing ? s_word_bits_ - shift : s_word_bits_, mask, out + row * s_lanes_);
+        }
+        for (size_t i = rows * s_lanes_; i < node_size_; ++i)
+            out[i] = static_cast<T>(unpack(words, i, bit_width));
+    }
+
+    // Replaces the deltas in keys by the running sum, starting at base
+    void prefix_sum(T* keys, T base) const {
+        size_t i = 0;
+#if defined(COMPRESSED_ARRAY_LINKED_LIST_SSE2)
+        // Each vector of deltas is summed with two shifted adds, then the last sum of the previous vector is added
+        if constexpr (sizeof(T) == 8) {
+            __m128i carry = _mm_set1_epi64x(static_cast<long long>(base));
+            for (; i + 2 <= node_size_; i += 2) {
+                __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+                values = _mm_add_epi64(values, _mm_slli_si128(values, 8));
+                values = _mm_add_epi64(values, carry);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(keys + i), values);
+                carry = _mm_shuffle_epi32(values, _MM_SHUFFLE(3, 2, 3, 2));
+            }
+        } else if constexpr (sizeof(T) == 4) {
+            __m128i carry = _mm_set1_epi32(static_cast<int>(base));
+            for (; i + 4 <= node_size_; i += 4) {
+                __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+                values = _mm_add_epi32(values, _mm_slli_si128(values, 4));
+                values = _mm_add_epi32(values, _mm_slli_si128(values, 8));
+                values = _mm_add_epi32(values, carry);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(keys + i), values);
+                carry = _mm_shuffle_epi32(values, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+        }
+#endif
+        T running = i == 0 ? base : keys[i - 1];
+        for (; i < node_size_; ++i) {
+            running = static_cast<T>(running + keys[i]);
+            keys[i] = running;
+        }
+    }
+
+    // Compresses the full tail keys into a new node
+    Node* seal(Node* prev) const {
+        T min = tail_keys_[0];
+        T max = tail_keys_[0];
+        bool monotone = true;
+        for (size_t i = 1; i < node_size_; ++i) {
+            min = std::min(min, tail_keys_[i]);
+            max = std::max(max, tail_keys_[i]);
+            monotone = monotone && tail_keys_[i] >= tail_keys_[i - 1];
+        }
+
+        // For monotone keys the largest delta is never larger than max - min, so deltas never need more bits
+        uint64_t largest = 0;
+        if (monotone) {
+            for (size_t i = 1; i < node_size_; ++i)
+                largest = std::max<uint64_t>(largest, static_cast<T>(tail_keys_[i] - tail_keys_[i - 1]));
+        } else {
+            largest = static_cast<uint64_t>(max - min);
+        }
+
+        uint8_t bit_width = bits_needed(largest);
+        Node* node = new Node(word_count(node_size_, bit_width), prev);
+        node->min = min;
+        node->max = max;
+        node->bit_width = bit_width;
+        node->delta_encoded = monotone;
+
+        if (bit_width == 0)
+            return node;
+
+        for (size_t i = 0; i < node_size_; ++i) {
+            uint64_t value;
+            if (monotone)
+                value = i == 0 ? 0 : static_cast<T>(tail_keys_[i] - tail_keys_[i - 1]);
+            else
+                value = static_cast<T>(tail_keys_[i] - min);
+
+            auto [word, shift] = bit_position(i, bit_width);
+            node->words[word] |= value << shift;
+            if (shift + bit_width > s_word_bits_)
+                node->words[word + s_lanes_] |= value >> (s_word_bits_ - shift);
+        }
+        return node;
+    }
+
+    // Decodes the keys of a sealed node into out, which must have room for node_size keys
+    void decode(const Node* node, T* out) const {
+        unpack_all(node->words, node->bit_width, out);
+
+        if (node->delta_encoded) {
+            prefix_sum(out, node->min);
+        } else {
+            for (size_t i = 0; i < node_size_; ++i)
+                out[i] = static_cast<T>(out[i] + node->min);
+        }
+    }
+
+    T decode_at(const Node* node, size_t index) const {
+        if (!node->delta_encoded)
+            return static_cast<T>(node->min + unpack(node->words, index, node->bit_width));
+
+        T result = node->min;
+        for (size_t i = 1; i <= index; ++i)
+            result = static_cast<T>(result + unpack(node->words, i, node->bit_width));
+        return result;
+    }
+
+    // Iterator class declarations
+
+   public:
+    class const_iterator {
+        friend class CompressedArrayLinkedList<T>;
+
+        const CompressedArrayLinkedList<T>* list_;
+
+        // nullptr while the iterator is in the tail keys
+        const Node* current_node_;
+        size_t node_index_;
+        size_t index_;
+
+        // Decoded keys of current_node_
+        std::vector<T> buffer_;
+
+        const_iterator(const CompressedArrayLinkedList<T>* list, const Node* node, size_t node_index, size_t index) :
+            list_(list),
+            current_node_(node),
+            node_index_(node_index),
+            index_(index) {
+            load_node();
+        }
+
+        // Takes the keys of node, which were already decoded into buffer
+        const_iterator(const CompressedArrayLinkedList<T>* list, const Node* node, size_t node_index, size_t index, std::vector<T>&& buffer) :
+            list_(list),
+            current_node_(node),
+            node_index_(node_index),
+            index_(index),
+            buffer_(std::move(buffer)) {}
+
+        void load_node() {
+            if (current_node_ != nullptr) {
+                buffer_.resize(list_->node_size_);
+                list_->decode(current_node_, buffer_.data());
+            }
+        }
+
+        size_t keys_size() const {
+            return current_node_ == nullptr ? list_->tail_size_ : list_->node_size_;
+        }
+
+       public:
+        using value_type = T;
+
+        const_iterator() :
+            list_(nullptr),
+            current_node_(nullptr),
+            node_index_(0),
+            index_(0) {}
+
+        const_iterator& operator++() {
+            ++index_;
+            if (index_ == keys_size() && node_index_ < list_->node_count_) {
+                ++node_index_;
+                current_node_ = current_node_->next;
+                index_ = 0;
+                load_node();
+            }
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return list_ == other.list_ && node_index_ == other.node_index_ && index_ == other.index_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+        const T& operator*() const {
+            return current_node_ == nullptr ? list_->tail_keys_[index_] : buffer_[index_];
+        }
+
+        const T* operator->() const {
+            return &**this;
+        }
+    };
+
+    using value_type = T;
+    using iterator = const_iterator;
+
+    // Utility for copying, moving and freeing
+
+   private:
+    void _free() {
+        Node* it = head_;
+        while (it != nullptr) {
+            Node* tmp = it;
+            it = it->next;
+            delete tmp;
+        }
+        delete[] tail_keys_;
+        head_ = tail_ = nullptr;
+        tail_keys_ = nullptr;
+        node_count_ = 0;
+        tail_size_ = 0;
+    }
+
+    void _init(size_t node_size) {
+        if (node_size == 0)
+            throw std::runtime_error("Node size must not be 0");
+
+        head_ = nullptr;
+        tail_ = nullptr;
+        tail_keys_ = nullptr;
+        node_size_ = node_size;
+        node_count_ = 0;
+        tail_size_ = 0;
+    }
+
+    void _copy(const CompressedArrayLinkedList<T>& other) {
+        try {
+            for (const Node* it = other.head_; it != nullptr; it = it->next) {
+                size_t words = word_count(node_size_, it->bit_width);
+                Node* node = new Node(words, tail_);
+                if (words != 0)
+                    std::memcpy(node->words, it->words, words * sizeof(uint64_t));
+                node->min = it->min;
+                node->max = it->max;
+                node->bit_width = it->bit_width;
+                node->delta_encoded = it->delta_encoded;
+
+                if (tail_ == nullptr)
+                    head_ = node;
+                else
+                    tail_->next = node;
+                tail_ = node;
+                ++node_count_;
+            }
+
+            if (other.tail_keys_ != nullptr) {
+                tail_keys_ = new T[node_size_];
+                std::copy(other.tail_keys_, other.tail_keys_ + other.tail_size_, tail_keys_);
+                tail_size_ = other.tail_size_;
+            }
+        } catch (...) {
+            _free();
+            throw;
+        }
+    }
+
+    void _move(CompressedArrayLinkedList<T>&& other) {
+        node_size_ = other.node_size_;
+        node_count_ = other.node_count_;
+        tail_size_ = other.tail_size_;
+        head_ = other.head_;
+        tail_ = other.tail_;
+        tail_keys_ = other.tail_keys_;
+
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.tail_keys_ = nullptr;
+        other.node_count_ = 0;
+        other.tail_size_ = 0;
+    }
+
+    // Constructors and Assignment operators
+
+   public:
+    explicit CompressedArrayLinkedList(size_t node_size = s_default_node_size_) {
+        _init(node_size);
+    }
+
+    // Compresses the keys of the given list, using the same node size
+    template <typename Allocator, size_t InlineCapacity>
+    explicit CompressedArrayLinkedList(const ArrayLinkedList<T, Allocator, InlineCapacity>& list) {
+        _init(list.node_size());
+        try {
+            for (auto it = list.cbegin(); it != list.cend(); ++it)
+                push_back(*it);
+        } catch (...) {
+            _free();
+            throw;
+        }
+    }
+
+    CompressedArrayLinkedList(const CompressedArrayLinkedList<T>& other) {
+        _init(other.node_size_);
+        _copy(other);
+    }
+
+    CompressedArrayLinkedList(CompressedArrayLinkedList<T>&& other) {
+        _move(std::move(other));
+    }
+
+    ~CompressedArrayLinkedList() {
+        _free();
+    }
+
+    CompressedArrayLinkedList<T>& operator=(const CompressedArrayLinkedList<T>& other) {
+        if (this != &other) {
+            CompressedArrayLinkedList<T> copy(other);
+            _free();
+            _move(std::move(copy));
+        }
+        return *this;
+    }
+
+    CompressedArrayLinkedList<T>& operator=(CompressedArrayLinkedList<T>&& other) {
+        _free();
+        _move(std::move(other));
+        return *this;
+    }
+
+    // Getters
+
+    size_t node_size() const {
+        return node_size_;
+    }
+
+    size_t size() const {
+        return node_count_ * node_size_ + tail_size_;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Returns the number of bytes used for the keys and nodes, without the list object itself
+    size_t memory_usage() const {
+        size_t result = tail_keys_ == nullptr ? 0 : node_size_ * sizeof(T);
+        for (const Node* it = head_; it != nullptr; it = it->next)
+            result += sizeof(Node) + word_count(node_size_, it->bit_width) * sizeof(uint64_t);
+        return result;
+    }
+
+    // Functions for getting iterators
+
+    const_iterator begin() const {
+        if (node_count_ == 0)
+            return const_iterator(this, nullptr, 0, 0);
+        return const_iterator(this, head_, 0, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, nullptr, node_count_, tail_size_);
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    T at(size_t index) const {
+        if (index >= size())
+            throw std::runtime_error("Index out of bounds");
+
+        size_t node_number = index / node_size_;
+        if (node_number == node_count_)
+            return tail_keys_[index - node_number * node_size_];
+
+        const Node* it = head_;
+        for (size_t i = 0; i < node_number; ++i)
+            it = it->next;
+        return decode_at(it, index - node_number * node_size_);
+    }
+
+    /*
+    Calls func(data, count) for the keys of every node, where data points to count contiguous keys.
+    Sealed nodes are decoded into a single buffer, so data is only valid during the call
+    */
+    template <typename Function>
+    void for_each_segment(Function func) const {
+        std::vector<T> buffer(node_count_ == 0 ? 0 : node_size_);
+        for (const Node* it = head_; it != nullptr; it = it->next) {
+            decode(it, buffer.data());
+            func(static_cast<const T*>(buffer.data()), node_size_);
+        }
+        if (tail_size_ != 0)
+            func(static_cast<const T*>(tail_keys_), tail_size_);
+    }
+
+    // find / contains methods
+
+    const_iterator find(const T& key) const {
+        std::vector<T> buffer;
+        size_t node_index = 0;
+        for (const Node* it = head_; it != nullptr; it = it->next, ++node_index) {
+            if (key < it->min || key > it->max)
+                continue;
+
+            buffer.resize(node_size_);
+            decode(it, buffer.data());
+            for (size_t i = 0; i < node_size_; ++i) {
+                if (buffer[i] == key)
+                    return const_iterator(this, it, node_index, i, std::move(buffer));
+            }
+        }
+
+        for (size_t i = 0; i < tail_size_; ++i) {
+            if (tail_keys_[i] == key)
+                return const_iterator(this, nullptr, node_count_, i);
+        }
+        return end();
+    }
+
+    bool contains(const T& key) const {
+        return find(key) != end();
+    }
+
+    // Functions that add items
+
+    void push_back(T key) {
+        if (tail_keys_ == nullptr) {
+            tail_keys_ = new T[node_size_];
+        } else if (tail_size_ == node_size_) {
+            Node* node = seal(tail_);
+            if (tail_ == nullptr)
+                head_ = node;
+            else
+                tail_->next = node;
+            tail_ = node;
+            ++node_count_;
+            tail_size_ = 0;
+        }
+
+        tail_keys_[tail_size_] = key;
+        ++tail_size_;
+    }
+
+    void clear() {
+        _free();
+    }
+};
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/*
+Append-only variant of ArrayLinkedList that can be filled by several threads at once.
+Each push_back reserves a slot in the current tail node with a fetch-add on the reservation counter of that node,
+if the node is full the thread that notices first links a new node with a CAS on tail->next.
+Readers take a snapshot, which only iterates over elements whose construction has been published
+*/
+template <typename T>
+class ConcurrentArrayLinkedList {
+    class Node {
+       public:
+        T* keys;
+        std::atomic<bool>* published;
+
+        std::atomic<size_t> reserved;
+        std::atomic<Node*> next;
+
+        explicit Node(size_t alloc_size) :
+            keys(new T[alloc_size]),
+            published(new std::atomic<bool>[alloc_size]),
+            reserved(0),
+            next(nullptr) {
+            for (size_t i = 0; i < alloc_size; ++i)
+                published[i].store(false, std::memory_order_relaxed);
+        }
+
+        ~Node() {
+            delete[] keys;
+            delete[] published;
+        }
+    };
+
+    static const size_t s_default_node_size_ = 50;
+
+    Node* head_;
+    std::atomic<Node*> tail_;
+
+    size_t node_size_;
+
+    // Snapshot and iterator declarations
+
+   public:
+    class Snapshot;
+
+    class const_iterator {
+        friend class Snapshot;
+
+        Node* current_node_;
+        size_t index_;
+        size_t node_size_;
+        Node* last_node_;
+        size_t last_size_;
+
+        const_iterator(Node* current_node, size_t index, size_t node_size, Node* last_node, size_t last_size) :
+            current_node_(current_node),
+            index_(index),
+            node_size_(node_size),
+            last_node_(last_node),
+            last_size_(last_size) {
+            skip_unpublished();
+        }
+       public:
+
+        using value_type = T;
+
+        const_iterator() :
+            current_node_(nullptr),
+            index_(0),
+            node_size_(0),
+            last_node_(nullptr),
+            last_size_(0) {}
+
+       private:
+        size_t current_size() const {
+            return current_node_ == last_node_ ? last_size_ : node_size_;
+        }
+
+        // Moves forward until the iterator points to a published element or to the end of the snapshot
+        void skip_unpublished() {
+            while (current_node_ != nullptr) {
+                for (; index_ < current_size(); ++index_) {
+                    if (current_node_->published[index_].load(std::memory_order_acquire))
+                        return;
+                }
+
+                if (current_node_ == last_node_)
+                    current_node_ = nullptr;
+                else
+                    current_node_ = current_node_->next.load(std::memory_order_acquire);
+                index_ = 0;
+            }
+        }
+
+       public:
+        const_iterator& operator++() {
+            ++index_;
+            skip_unpublished();
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return current_node_ == other.current_node_ && index_ == other.index_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+        const T& operator*() const {
+            return current_node_->keys[index_];
+        }
+
+        const T* operator->() const {
+            return &current_node_->keys[index_];
+        }
+    };
+
+    /*
+    Read-only view of the list at the time it was taken. Elements that were reserved, but not yet published
+    when the snapshot was iterated over are skipped, elements appended after the snapshot was taken are never visited
+    */
+    class Snapshot {
+        friend class ConcurrentArrayLinkedList<T>;
+
+        Node* head_;
+        Node* last_node_;
+        size_t last_size_;
+        size_t node_size_;
+
+        Snapshot(Node* head, Node* last_node, size_t last_size, size_t node_size) :
+            head_(head),
+            last_node_(last_node),
+            last_size_(last_size),
+            node_size_(node_size) {}
+
+       public:
+        const_iterator begin() const {
+            return const_iterator(head_, 0, node_size_, last_node_, last_size_);
+        }
+
+        const_iterator end() const {
+            return const_iterator();
+        }
+
+        // Counts the published elements, so this is linear in the size of the snapshot
+        size_t size() const {
+            size_t result = 0;
+            for (auto it = begin(); it != end(); ++it)
+                ++result;
+            return result;
+        }
+    };
+
+    using value_type = T;
+
+    // Constructors and Destructor
+
+    explicit ConcurrentArrayLinkedList(size_t node_size = s_default_node_size_) :
+        head_(new Node(node_size)),
+        tail_(head_),
+        node_size_(node_size) {}
+
+    ConcurrentArrayLinkedList(const ConcurrentArrayLinkedList<T>& other) = delete;
+    ConcurrentArrayLinkedList<T>& operator=(const ConcurrentArrayLinkedList<T>& other) = delete;
+
+    // Must not be called while other threads are still appending
+    ~ConcurrentArrayLinkedList() {
+        Node* it = head_;
+        while (it != nullptr) {
+            Node* tmp = it;
+            it = it->next.load(std::memory_order_relaxed);
+            delete tmp;
+        }
+    }
+
+    size_t node_size() const {
+        return node_size_;
+    }
+
+    Snapshot snapshot() const {
+        Node* last_node = tail_.load(std::memory_order_acquire);
+        size_t reserved = last_node->reserved.load(std::memory_order_acquire);
+        size_t last_size = reserved < node_size_ ? reserved : node_size_;
+        return Snapshot(head_, last_node, last_size, node_size_);
+    }
+
+    // Functions that add items
+
+   private:
+    /*
+    Links a new node after the given full node if no other thread has done that yet and
+    tries to advance tail_ to it. Returns the node following the full node
+    */
+    Node* roll_over(Node* full_node) {
+        Node* next = full_node->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            Node* new_node = new Node(node_size_);
+            if (full_node->next.compare_exchange_strong(next, new_node, std::memory_order_acq_rel, std::memory_order_acquire))
+                next = new_node;
+            else
+                delete new_node;
+        }
+
+        tail_.compare_exchange_strong(full_node, next, std::memory_order_acq_rel, std::memory_order_relaxed);
+        return next;
+    }
+
+    /*
+    Implements logic for appending a new element. The actual insertion is passed as a function that takes the slot the key is to be written to.
+    If the insertion throws, the reserved slot is never published and stays invisible to readers
+    */
+    template <typename Function>
+    void push_back_template(Function func) {
+        Node* tail = tail_.load(std::memory_order_acquire);
+        while (true) {
+            size_t index = tail->reserved.fetch_add(1, std::memory_order_relaxed);
+            if (index < node_size_) {
+                func(tail->keys[index]);
+                tail->published[index].store(true, std::memory_order_release);
+                return;
+            }
+
+            tail = roll_over(tail);
+        }
+    }
+
+   public:
+    void push_back(const T& key) {
+        push_back_template([&](T& slot) {
+            slot = key;
+        });
+    }
+
+    void push_back(T&& key) {
+        push_back_template([&](T& slot) {
+            slot = std::move(key);
+        });
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        push_back_template([&](T& slot) {
+            slot = T(std::forward<Args>(args)...);
+        });
+    }
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+Memory source for HugePageAllocator. Blocks are carved out of 2MB slabs, which are aligned to 2MB and marked with
+madvise(MADV_HUGEPAGE), so the kernel can back each of them with a single transparent huge page.
+If a NUMA node is given, the slabs are bound to that node with mbind (MPOL_PREFERRED) before they are touched.
+Freed blocks are kept in a free list per block size and alignment, so they are only handed out again for requests they
+are aligned for, and are only returned to the system when the arena is destroyed.
+On platforms other than linux the slabs are aligned heap allocations without any placement hints
+*/
+class HugePageArena {
+    static const size_t s_slab_size_ = size_t(2) * 1024 * 1024;
+    static const size_t s_min_alignment_ = 16;
+
+    struct Slab {
+        void* memory;
+        size_t size;
+    };
+
+    std::mutex mutex_;
+    std::vector<Slab> slabs_;
+    std::map<std::pair<size_t, size_t>, std::vector<void*>> free_blocks_;
+
+    char* current_;
+    size_t remaining_;
+    int numa_node_;
+
+    static size_t round_up(size_t size, size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    void* map_slab(size_t size) {
+#if defined(__linux__)
+        // Map an extra slab so the mapping can be trimmed to a 2MB aligned range
+        size_t mapped_size = size + s_slab_size_;
+        void* mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED)
+            throw std::bad_alloc();
+
+        uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+        uintptr_t aligned = round_up(begin, s_slab_size_);
+        if (aligned != begin)
+            munmap(mapped, aligned - begin);
+        size_t tail_size = begin + mapped_size - (aligned + size);
+        if (tail_size != 0)
+            munmap(reinterpret_cast<void*>(aligned + size), tail_size);
+
+        void* memory = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        // This is only a hint, so failure (e.g. transparent huge pages being disabled) is ignored
+        madvise(memory, size, MADV_HUGEPAGE);
+#endif
+#ifdef SYS_mbind
+        if (numa_node_ >= 0 && numa_node_ < static_cast<int>(sizeof(unsigned long) * 8)) {
+            const int mpol_preferred = 1;
+            unsigned long node_mask = 1UL << numa_node_;
+            syscall(SYS_mbind, memory, size, mpol_preferred, &node_mask, sizeof(node_mask) * 8, 0);
+        }
+#endif
+        return memory;
+#else
+        return ::operator new(size, std::align_val_t(s_slab_size_));
+#endif
+    }
+
+    static void unmap_slab(const Slab& slab) {
+#if defined(__linux__)
+        munmap(slab.memory, slab.size);
+#else
+        ::operator delete(slab.memory, std::align_val_t(s_slab_size_));
+#endif
+    }
+
+   public:
+    // numa_node is the node the slabs are bound to, or -1 to leave the placement to the kernel
+    explicit HugePageArena(int numa_node = -1) :
+        current_(nullptr),
+        remaining_(0),
+        numa_node_(numa_node) {}
+
+    HugePageArena(const HugePageArena& other) = delete;
+    HugePageArena& operator=(const HugePageArena& other) = delete;
+
+    ~HugePageArena() {
+        for (const Slab& slab : slabs_)
+            unmap_slab(slab);
+    }
+
+    int numa_node() const {
+        return numa_node_;
+    }
+
+    // Returns the number of slabs mapped so far
+    size_t slab_count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slabs_.size();
+    }
+
+    void* allocate(size_t size, size_t alignment) {
+        if (alignment < s_min_alignment_)
+            alignment = s_min_alignment_;
+        size = round_up(size, alignment);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto free_it = free_blocks_.find({size, alignment});
+        if (free_it != free_blocks_.end() && !free_it->second.empty()) {
+            void* block = free_it->second.back();
+            free_it->second.pop_back();
+            return block;
+        }
+
+        // Blocks larger than a quarter of a slab get their own slabs, so little of the current slab is wasted
+        if (size > s_slab_size_ / 4) {
+            size_t slab_size = round_up(size, s_slab_size_);
+            slabs_.reserve(slabs_.size() + 1);
+            void* memory = map_slab(slab_size);
+            slabs_.push_back({memory, slab_size});
+            return memory;
+        }
+
+        size_t padding = round_up(reinterpret_cast<uintptr_t>(current_), alignment) - reinterpret_cast<uintptr_t>(current_);
+        if (current_ == nullptr || padding + size > remaining_) {
+            slabs_.reserve(slabs_.size() + 1);
+            current_ = static_cast<char*>(map_slab(s_slab_size_));
+            remaining_ = s_slab_size_;
+            slabs_.push_back({current_, s_slab_size_});
+            padding = 0;
+        }
+
+        void* block = current_ + padding;
+        current_ += padding + size;
+        remaining_ -= padding + size;
+        return block;
+    }
+
+    void deallocate(void* block, size_t size, size_t alignment) {
+        if (alignment < s_min_alignment_)
+            alignment = s_min_alignment_;
+        size = round_up(size, alignment);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_blocks_[{size, alignment}].push_back(block);
+    }
+};
+
+/*
+Allocator for ArrayLinkedList (e.g. ArrayLinkedList<T, HugePageAllocator<T>>) that places the nodes in huge page backed slabs
+of a HugePageArena, which reduces TLB misses when traversing large lists. Copies of an allocator share the same arena,
+a default constructed allocator creates its own arena, so every list gets its own slabs unless an allocator is passed to it
+*/
+template <typename T>
+class HugePageAllocator {
+    template <typename U>
+    friend class HugePageAllocator;
+
+    std::shared_ptr<HugePageArena> arena_;
+
+   public:
+    using value_type = T;
+
+    HugePageAllocator() :
+        arena_(std::make_shared<HugePageArena>()) {}
+
+    // Binds the slabs of the new arena to the given NUMA node
+    explicit HugePageAllocator(int numa_node) :
+        arena_(std::make_shared<HugePageArena>(numa_node)) {}
+
+    explicit HugePageAllocator(std::shared_ptr<HugePageArena> arena) :
+        arena_(std::move(arena)) {}
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) :
+        arena_(other.arena_) {}
+
+    const std::shared_ptr<HugePageArena>& arena() const {
+        return arena_;
+    }
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) {
+        arena_->deallocate(pointer, count * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>& other) const {
+        return arena_ == other.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>& other) const {
+        return !(*this == other);
+    }
+};
@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ArrayLinkedList.h"
+
+/*
+Immutable list that stores its keys in chunks of node_size like ArrayLinkedList, but organizes the chunks as the leaves
+of a shallow tree instead of a linked list. Every changing operation returns a new version of the list, that shares all
+nodes with the old version except for the changed leaf and the branches on the path to it.
+Branches store the accumulated sizes of their children, so leaves do not have to be full (like in an RRB tree) and
+erase only has to copy a single path instead of shifting all following keys. Lookup is logarithmic in the number of leaves
+*/
+template <typename T>
+class PersistentArrayLinkedList {
+    class Node {
+       public:
+        // Only used by leaves
+        std::vector<T> keys;
+
+        // Only used by branches, sizes[i] is the number of keys in children[0] to children[i]
+        std::vector<std::shared_ptr<const Node>> children;
+        std::vector<size_t> sizes;
+    };
+
+    using NodePtr = std::shared_ptr<const Node>;
+
+    static const size_t s_default_node_size_ = 50;
+    static const size_t s_branching_factor_ = 32;
+
+    NodePtr root_;
+
+    // The height of a leaf is 0, all leaves have the same depth
+    size_t height_;
+    size_t node_size_;
+    size_t size_;
+
+    PersistentArrayLinkedList(NodePtr root, size_t height, size_t node_size, size_t size) :
+        root_(std::move(root)),
+        height_(height),
+        node_size_(node_size),
+        size_(size) {}
+
+    // Utility for building and searching the tree
+
+    static std::shared_ptr<Node> make_branch(std::vector<NodePtr> children) {
+        auto branch = std::make_shared<Node>();
+        branch->children = std::move(children);
+        update_sizes(*branch);
+        return branch;
+    }
+
+    static void update_sizes(Node& branch) {
+        branch.sizes.resize(branch.children.size());
+        size_t accumulated = 0;
+        for (size_t i = 0; i < branch.children.size(); ++i) {
+            const Node& child = *branch.children[i];
+            accumulated += child.children.empty() ? child.keys.size() : child.sizes.back();
+            branch.sizes[i] = accumulated;
+        }
+    }
+
+    // Returns the index of the child of the branch containing the given index and makes the index relative to that child
+    static size_t child_index(const Node& branch, size_t& index) {
+        size_t i = std::upper_bound(branch.sizes.begin(), branch.sizes.end(), index) - branch.sizes.begin();
+        if (i > 0)
+            index -= branch.sizes[i - 1];
+        return i;
+    }
+
+    // Returns the leaf containing the given index and makes the index relative to that leaf
+    const Node* find_leaf(size_t& index) const {
+        const Node* it = root_.get();
+        for (size_t height = height_; height > 0; --height)
+            it = it->children[child_index(*it, index)].get();
+        return it;
+    }
+
+    // Builds the tree bottom up from full leaves, which is used by the constructors
+    template <typename It>
+    void build(It begin, It end) {
+        std::vector<NodePtr> level;
+        std::shared_ptr<Node> leaf;
+        for (It it = begin; it != end; ++it) {
+            if (leaf == nullptr || leaf->keys.size() == node_size_) {
+                leaf = std::make_shared<Node>();
+                leaf->keys.reserve(node_size_);
+                level.push_back(leaf);
+            }
+            leaf->keys.push_back(*it);
+            ++size_;
+        }
+
+        if (level.empty())
+            return;
+
+        while (level.size() > 1) {
+            std::vector<NodePtr> next_level;
+            for (size_t i = 0; i < level.size(); i += s_branching_factor_) {
+                size_t group_end = std::min(i + s_branching_factor_, level.size());
+                next_level.push_back(make_branch(std::vector<NodePtr>(level.begin() + i, level.begin() + group_end)));
+            }
+            level = std::move(next_level);
+            ++height_;
+        }
+        root_ = level.front();
+    }
+
+    // Recursive implementations of the changing operations, they copy every node on the path they take
+
+    /*
+    Appends the key to the rightmost leaf below node. Returns the copied node and, if there was no room left below node,
+    a new node of the same height holding only the key, which has to be added next to node by the caller
+    */
+    std::pair<NodePtr, NodePtr> push_back_rec(const NodePtr& node, size_t height, const T& key) const {
+        if (height == 0) {
+            if (node->keys.size() < node_size_) {
+                auto result = std::make_shared<Node>(*node);
+                result->keys.push_back(key);
+                return std::make_pair(result, nullptr);
+            }
+
+            auto overflow = std::make_shared<Node>();
+            overflow->keys.reserve(node_size_);
+            overflow->keys.push_back(key);
+            return std::make_pair(node, overflow);
+        }
+
+        auto [child, child_overflow] = push_back_rec(node->children.back(), height - 1, key);
+        auto result = std::make_shared<Node>(*node);
+        result->children.back() = child;
+
+        NodePtr overflow;
+        if (child_overflow != nullptr) {
+            if (result->children.size() < s_branching_factor_)
+                result->children.push_back(child_overflow);
+            else
+                overflow = make_branch({child_overflow});
+        }
+
+        update_sizes(*result);
+        return std::make_pair(result, overflow);
+    }
+
+    NodePtr set_rec(const NodePtr& node, size_t height, size_t index, const T& key) const {
+        auto result = std::make_shared<Node>(*node);
+        if (height == 0) {
+            result->keys[index] = key;
+        } else {
+            size_t i = child_index(*node, index);
+            result->children[i] = set_rec(node->children[i], height - 1, index, key);
+        }
+        return result;
+    }
+
+    // Returns the copied node without the key at the given index or nullptr if the node does not contain any keys anymore
+    NodePtr erase_rec(const NodePtr& node, size_t height, size_t index) const {
+        auto result = std::make_shared<Node>(*node);
+        if (height == 0) {
+            result->keys.erase(result->keys.begin() + index);
+            return result->keys.empty() ? nullptr : result;
+        }
+
+        size_t i = child_index(*node, index);
+        NodePtr child = erase_rec(node->children[i], height - 1, index);
+        if (child != nullptr)
+            result->children[i] = child;
+        else
+            result->children.erase(result->children.begin() + i);
+
+        if (result->children.empty())
+            return nullptr;
+
+        update_sizes(*result);
+        return result;
+    }
+
+    void check_index(size_t index) const {
+        if (index >= size_)
+            throw std::runtime_error("Index out of bounds");
+    }
+
+    // Iterator class declarations
+
+   public:
+    class const_iterator {
+        friend class PersistentArrayLinkedList<T>;
+
+        const PersistentArrayLinkedList<T>* list_;
+        size_t index_;
+        const Node* leaf_;
+        size_t leaf_index_;
+
+        const_iterator(const PersistentArrayLinkedList<T>* list, size_t index) :
+            list_(list),
+            index_(index),
+            leaf_(nullptr),
+            leaf_index_(0) {
+            load_leaf();
+        }
+
+        void load_leaf() {
+            if (index_ < list_->size_) {
+                leaf_index_ = index_;
+                leaf_ = list_->find_leaf(leaf_index_);
+            } else {
+                leaf_ = nullptr;
+                leaf_index_ = 0;
+            }
+        }
+
+       public:
+        using value_type = T;
+
+        const_iterator() :
+            list_(nullptr),
+            index_(0),
+            leaf_(nullptr),
+            leaf_index_(0) {}
+
+        const_iterator& operator++() {
+            ++index_;
+            ++leaf_index_;
+            if (leaf_index_ == leaf_->keys.size())
+                load_leaf();
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return list_ == other.list_ && index_ == other.index_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+        const T& operator*() const {
+            return leaf_->keys[leaf_index_];
+        }
+
+        const T* operator->() const {
+            return &leaf_->keys[leaf_index_];
+        }
+    };
+
+    using value_type = T;
+    using iterator = const_iterator;
+
+    // Constructors
+
+    explicit PersistentArrayLinkedList(size_t node_size = s_default_node_size_) :
+        root_(nullptr),
+        height_(0),
+        node_size_(node_size),
+        size_(0) {}
+
+    PersistentArrayLinkedList(std::initializer_list<T> init, size_t node_size = s_default_node_size_) :
+        PersistentArrayLinkedList(node_size) {
+        build(init.begin(), init.end());
+    }
+
+    // Creates the first version from the keys of the given list, using the same node size
+    template <typename Allocator, size_t InlineCapacity>
+    explicit PersistentArrayLinkedList(const ArrayLinkedList<T, Allocator, InlineCapacity>& list) :
+        PersistentArrayLinkedList(list.node_size()) {
+        build(list.cbegin(), list.cend());
+    }
+
+    // Getters
+
+    size_t node_size() const {
+        return node_size_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    const T& at(size_t index) const {
+        check_index(index);
+        const Node* leaf = find_leaf(index);
+        return leaf->keys[index];
+    }
+
+    const T& front() const {
+        return at(0);
+    }
+
+    const T& back() const {
+        return at(size_ - 1);
+    }
+
+    // Functions for getting iterators, they are only valid as long as this version exists
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, size_);
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator cend() const {
+        return end();
+    }
+
+    // Functions that create new versions
+
+    PersistentArrayLinkedList<T> push_back(const T& key) const {
+        if (root_ == nullptr) {
+            auto leaf = std::make_shared<Node>();
+            leaf->keys.reserve(node_size_);
+            leaf->keys.push_back(key);
+            return PersistentArrayLinkedList<T>(leaf, 0, node_size_, 1);
+        }
+
+        auto [root, overflow] = push_back_rec(root_, height_, key);
+        if (overflow == nullptr)
+            return PersistentArrayLinkedList<T>(root, height_, node_size_, size_ + 1);
+
+        return PersistentArrayLinkedList<T>(make_branch({root, overflow}), height_ + 1, node_size_, size_ + 1);
+    }
+
+    PersistentArrayLinkedList<T> set(size_t index, const T& key) const {
+        check_index(index);
+        return PersistentArrayLinkedList<T>(set_rec(root_, height_, index, key), height_, node_size_, size_);
+    }
+
+    /*
+    Leaves are not merged after erasing, so a leaf may end up with fewer than node_size keys.
+    Leaves that become empty are removed from the tree
+    */
+    PersistentArrayLinkedList<T> erase(size_t index) const {
+        check_index(index);
+        NodePtr root = erase_rec(root_, height_, index);
+        size_t height = root == nullptr ? 0 : height_;
+        while (height > 0 && root->children.size() == 1) {
+            root = root->children.front();
+            --height;
+        }
+
+        return PersistentArrayLinkedList<T>(root, height, node_size_, size_ - 1);
+    }
+};
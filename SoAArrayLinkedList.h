@@ -0,0 +1,454 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/*
+Implementation of SoAArrayLinkedList, which stores records of the type Record in one column per field of the types Fields.
+Records can be pushed as a Record (using std::get or a get found by argument dependent lookup) or as separate fields
+*/
+template <typename Record, typename... Fields>
+class SoAColumnList {
+    using Indices = std::index_sequence_for<Fields...>;
+
+    class Node {
+       public:
+        std::tuple<Fields*...> columns;
+
+        Node* next;
+        Node* prev;
+
+        // The columns are allocated one after another, so the ones allocated before a failing allocation can be freed
+        Node(size_t alloc_size, Node* prev = nullptr) :
+            columns(),
+            next(nullptr),
+            prev(prev) {
+            try {
+                allocate_columns(alloc_size, Indices());
+            } catch (...) {
+                free_columns();
+                throw;
+            }
+        }
+
+        ~Node() {
+            free_columns();
+        }
+
+       private:
+        template <size_t... Is>
+        void allocate_columns(size_t alloc_size, std::index_sequence<Is...>) {
+            (allocate_column<Is>(alloc_size), ...);
+        }
+
+        // Every column is allocated in a full-expression of its own. With all of them in one expression, GCC 12 destroys
+        // the values of an earlier column when a later allocation throws, so freeing that column destroyed them twice
+        template <size_t I>
+        void allocate_column(size_t alloc_size) {
+            std::get<I>(columns) = new field_type<I>[alloc_size];
+        }
+
+        void free_columns() {
+            std::apply([](auto*... column) {
+                (delete[] column, ...);
+            }, columns);
+        }
+    };
+
+    static const size_t s_default_node_size_ = 50;
+
+    Node* head_;
+    Node* tail_;
+
+    size_t node_size_;
+    size_t node_count_;
+    size_t tail_size_;
+
+   public:
+    using value_type = Record;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+   private:
+    template <size_t... Is>
+    static reference make_reference(Node* node, size_t index, std::index_sequence<Is...>) {
+        return reference(std::get<Is>(node->columns)[index]...);
+    }
+
+    template <size_t... Is>
+    static const_reference make_const_reference(const Node* node, size_t index, std::index_sequence<Is...>) {
+        return const_reference(std::get<Is>(node->columns)[index]...);
+    }
+
+    // Iterator class declarations
+
+    template <bool constant>
+    class Iterator {
+        template <typename OtherRecord, typename... OtherFields>
+        friend class SoAColumnList;
+
+        Node* current_node_;
+        size_t index_;
+        size_t node_size_;
+        const size_t* tail_size_;
+
+        Iterator(Node* current_node, size_t index, size_t node_size, const size_t* tail_size) :
+            current_node_(current_node),
+            index_(index),
+            node_size_(node_size),
+            tail_size_(tail_size) {}
+       public:
+
+        using value_type = SoAColumnList::value_type;
+        using reference = std::conditional_t<constant, const_reference, SoAColumnList::reference>;
+
+        Iterator() :
+            current_node_(nullptr),
+            index_(0),
+            node_size_(0),
+            tail_size_(nullptr) {}
+
+        Iterator& operator++() {
+            if ((current_node_->next == nullptr && index_ < *tail_size_ - 1) || (current_node_->next != nullptr && index_ < node_size_ - 1)) {
+                ++index_;
+            } else {
+                current_node_ = current_node_->next;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        Iterator& operator--() {
+            if (index_ > 0) {
+                --index_;
+            } else {
+                current_node_ = current_node_->prev;
+                index_ = node_size_ - 1;
+            }
+            return *this;
+        }
+
+        template <bool param>
+        bool operator==(const Iterator<param>& other) const {
+            return current_node_ == other.current_node_ && index_ == other.index_;
+        }
+
+        template <bool param>
+        bool operator!=(const Iterator<param>& other) const {
+            return !(*this == other);
+        }
+
+        reference operator*() const {
+            if constexpr (constant)
+                return make_const_reference(current_node_, index_, Indices());
+            else
+                return make_reference(current_node_, index_, Indices());
+        }
+
+        // Returns a reference to a single field of the record this iterator points to
+        template <size_t I>
+        std::conditional_t<constant, const field_type<I>&, field_type<I>&> get() const {
+            return std::get<I>(current_node_->columns)[index_];
+        }
+    };
+
+   public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // Utility for copying, moving and freeing
+
+   private:
+    void _free() {
+        Node* it = head_;
+        while (it != nullptr) {
+            Node* tmp = it;
+            it = it->next;
+            delete tmp;
+        }
+        head_ = tail_ = nullptr;
+        node_count_ = 0;
+        tail_size_ = 0;
+    }
+
+    void _init(size_t node_size) {
+        head_ = nullptr;
+        tail_ = nullptr;
+        node_size_ = node_size;
+        node_count_ = 0;
+        tail_size_ = 0;
+    }
+
+    void _move(SoAColumnList<Record, Fields...>&& other) {
+        node_size_ = other.node_size_;
+        node_count_ = other.node_count_;
+        tail_size_ = other.tail_size_;
+        head_ = other.head_;
+        tail_ = other.tail_;
+
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.node_count_ = 0;
+        other.tail_size_ = 0;
+    }
+
+    // Constructors and Assignment operators
+
+   public:
+    explicit SoAColumnList(size_t node_size = s_default_node_size_) {
+        _init(node_size);
+    }
+
+    SoAColumnList(const SoAColumnList<Record, Fields...>& other) {
+        _init(other.node_size_);
+        try {
+            for (const_reference record : other)
+                push_back(record);
+        } catch (...) {
+            _free();
+            throw;
+        }
+    }
+
+    SoAColumnList(SoAColumnList<Record, Fields...>&& other) {
+        _move(std::move(other));
+    }
+
+    ~SoAColumnList() {
+        _free();
+    }
+
+    SoAColumnList<Record, Fields...>& operator=(const SoAColumnList<Record, Fields...>& other) {
+        if (this != &other) {
+            SoAColumnList<Record, Fields...> copy(other);
+            _free();
+            _move(std::move(copy));
+        }
+        return *this;
+    }
+
+    SoAColumnList<Record, Fields...>& operator=(SoAColumnList<Record, Fields...>&& other) {
+        _free();
+        _move(std::move(other));
+        return *this;
+    }
+
+    // Getters
+
+    size_t node_size() const {
+        return node_size_;
+    }
+
+    size_t size() const {
+        if (node_count_ == 0)
+            return 0;
+        else
+            return (node_count_ - 1) * node_size_ + tail_size_;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Functions for getting iterators
+
+    iterator begin() noexcept {
+        return iterator(head_, 0, node_size_, &tail_size_);
+    }
+
+    iterator end() noexcept {
+        return iterator(nullptr, 0, node_size_, &tail_size_);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return const_iterator(head_, 0, node_size_, &tail_size_);
+    }
+
+    const_iterator cend() const noexcept {
+        return const_iterator(nullptr, 0, node_size_, &tail_size_);
+    }
+
+    const_iterator begin() const noexcept {
+        return cbegin();
+    }
+
+    const_iterator end() const noexcept {
+        return cend();
+    }
+
+   private:
+    std::pair<Node*, size_t> find_index(size_t index) const {
+        if (index < size()) {
+            size_t node_number = index / node_size_;
+
+            Node* it = head_;
+            for (size_t i = 0; i < node_number; ++i)
+                it = it->next;
+
+            return std::make_pair(it, index - node_number * node_size_);
+        } else {
+            throw std::runtime_error("Index out of bounds");
+        }
+    }
+
+   public:
+    reference at(size_t index) {
+        auto [node, node_index] = find_index(index);
+        return make_reference(node, node_index, Indices());
+    }
+
+    const_reference at(size_t index) const {
+        auto [node, node_index] = find_index(index);
+        return make_const_reference(node, node_index, Indices());
+    }
+
+    // Column access
+
+    /*
+    Calls func(data, count) for the column of field I of every node, where data points to count contiguous values.
+    Loops over a single column like this can be vectorized by the compiler
+    */
+    template <size_t I, typename Function>
+    void for_each_segment(Function func) const {
+        for (Node* it = head_; it != nullptr; it = it->next) {
+            size_t keys_size = it->next == nullptr ? tail_size_ : node_size_;
+            func(static_cast<const field_type<I>*>(std::get<I>(it->columns)), keys_size);
+        }
+    }
+
+    template <size_t I, typename Function>
+    void for_each_segment(Function func) {
+        for (Node* it = head_; it != nullptr; it = it->next) {
+            size_t keys_size = it->next == nullptr ? tail_size_ : node_size_;
+            func(std::get<I>(it->columns), keys_size);
+        }
+    }
+
+    // Functions that add items
+
+   private:
+    template <typename TupleLike, size_t... Is>
+    void assign_record(Node* node, size_t index, TupleLike&& record, std::index_sequence<Is...>) {
+        using std::get;
+        ((std::get<Is>(node->columns)[index] = get<Is>(std::forward<TupleLike>(record))), ...);
+    }
+
+    template <typename TupleLike>
+    void push_back_record(TupleLike&& record) {
+        bool appended = true;
+        if (head_ == nullptr) {
+            head_ = tail_ = new Node(node_size_);
+            node_count_ = 1;
+        } else if (tail_size_ == node_size_) {
+            tail_->next = new Node(node_size_, tail_);
+            ++node_count_;
+            tail_ = tail_->next;
+            tail_size_ = 0;
+        } else {
+            appended = false;
+        }
+
+        // A node that was appended for the record is removed again if a field cannot be assigned
+        try {
+            assign_record(tail_, tail_size_, std::forward<TupleLike>(record), Indices());
+        } catch (...) {
+            if (appended) {
+                Node* prev_tail = tail_;
+                tail_ = tail_->prev;
+                if (tail_ == nullptr)
+                    head_ = nullptr;
+                else
+                    tail_->next = nullptr;
+                tail_size_ = tail_ == nullptr ? 0 : node_size_;
+                delete prev_tail;
+                --node_count_;
+            }
+            throw;
+        }
+        ++tail_size_;
+    }
+
+   public:
+    void push_back(const Fields&... fields) {
+        push_back_record(std::forward_as_tuple(fields...));
+    }
+
+    void push_back(const Record& record) {
+        push_back_record(record);
+    }
+
+    template <typename... Args>
+    void push_back(const std::tuple<Args...>& record) {
+        push_back_record(record);
+    }
+
+    template <typename... Args>
+    void push_back(std::tuple<Args...>&& record) {
+        push_back_record(std::move(record));
+    }
+
+    // Deletion functions
+
+    void pop_back() {
+        if (tail_size_ > 1) {
+            --tail_size_;
+        } else {
+            Node* prev_tail = tail_;
+            tail_ = tail_->prev;
+            if (tail_ == nullptr) {
+                tail_size_ = 0;
+                head_ = nullptr;
+            } else {
+                tail_->next = nullptr;
+                tail_size_ = node_size_;
+            }
+            delete prev_tail;
+            --node_count_;
+        }
+    }
+
+    void clear() {
+        _free();
+    }
+};
+
+/*
+Variant of ArrayLinkedList for records made of the given fields, that stores the records in structure of arrays layout.
+Every node holds one contiguous column per field, so a scan that only reads a single field only pulls that field through the cache.
+Iterators and at() return tuples of references to the fields of a record (proxy references), for_each_segment() gives
+direct access to the columns of every node.
+A single tuple-like type (one that specializes std::tuple_size and std::tuple_element and has a get, like std::pair or
+a struct providing them) is split into its elements, so SoAArrayLinkedList<Record> has one column per element of Record
+*/
+template <typename... Fields>
+class SoAArrayLinkedList : public SoAColumnList<std::tuple<Fields...>, Fields...> {
+   public:
+    using SoAColumnList<std::tuple<Fields...>, Fields...>::SoAColumnList;
+};
+
+template <typename Record, typename = void>
+struct SoARecordColumns {
+    using type = SoAColumnList<std::tuple<Record>, Record>;
+};
+
+template <typename Record, size_t... Is>
+SoAColumnList<Record, std::tuple_element_t<Is, Record>...> soa_record_columns(std::index_sequence<Is...>);
+
+template <typename Record>
+struct SoARecordColumns<Record, std::void_t<decltype(std::tuple_size<Record>::value)>> {
+    using type = decltype(soa_record_columns<Record>(std::make_index_sequence<std::tuple_size<Record>::value>()));
+};
+
+template <typename Record>
+class SoAArrayLinkedList<Record> : public SoARecordColumns<Record>::type {
+    using Columns = typename SoARecordColumns<Record>::type;
+
+   public:
+    using Columns::Columns;
+};
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "ArrayLinkedList.h"
+
+/*
+Slot map built on top of ArrayLinkedList. Items are never moved after they were inserted, erasing an item only marks
+its slot as free and the slot is reused by a later insertion. Every insertion returns a Handle, that stays valid until
+its item is erased and is detected as stale afterwards, because each slot carries a generation that is incremented on erase.
+Slots are only freed when the list holding them is destroyed, so handles must not be used after that
+*/
+template <typename T>
+class StableArrayLinkedList {
+    class Slot {
+       public:
+        T value;
+        uint32_t generation;
+        bool alive;
+        Slot* next_free;
+
+        Slot() :
+            value(),
+            generation(0),
+            alive(false),
+            next_free(nullptr) {}
+    };
+
+    static const size_t s_default_node_size_ = 50;
+
+    ArrayLinkedList<Slot> slots_;
+    Slot* free_list_;
+    size_t size_;
+
+    // Handle and Iterator class declarations
+
+   public:
+    class Handle {
+        friend class StableArrayLinkedList<T>;
+
+        Slot* slot_;
+        uint32_t generation_;
+
+        Handle(Slot* slot, uint32_t generation) :
+            slot_(slot),
+            generation_(generation) {}
+
+       public:
+        Handle() :
+            slot_(nullptr),
+            generation_(0) {}
+
+        bool operator==(const Handle& other) const {
+            return slot_ == other.slot_ && generation_ == other.generation_;
+        }
+
+        bool operator!=(const Handle& other) const {
+            return !(*this == other);
+        }
+    };
+
+   private:
+    template <bool constant>
+    class Iterator {
+        friend class StableArrayLinkedList<T>;
+
+        using SlotIterator = std::conditional_t<constant, typename ArrayLinkedList<Slot>::const_iterator, typename ArrayLinkedList<Slot>::iterator>;
+
+        SlotIterator current_;
+        SlotIterator end_;
+
+        Iterator(SlotIterator current, SlotIterator end) :
+            current_(current),
+            end_(end) {
+            skip_free();
+        }
+
+        void skip_free() {
+            while (current_ != end_ && !current_->alive)
+                ++current_;
+        }
+
+       public:
+        using value_type = T;
+
+        Iterator() = default;
+
+        Iterator& operator++() {
+            ++current_;
+            skip_free();
+            return *this;
+        }
+
+        template <bool param>
+        bool operator==(const Iterator<param>& other) const {
+            return current_ == other.current_;
+        }
+
+        template <bool param>
+        bool operator!=(const Iterator<param>& other) const {
+            return !(*this == other);
+        }
+
+        // Returns a handle to the item this iterator points to
+        Handle handle() const {
+            return Handle(const_cast<Slot*>(&*current_), current_->generation);
+        }
+
+        const T& operator*() const {
+            return current_->value;
+        }
+
+        template <bool c = constant, typename = std::enable_if_t<!c>>
+        T& operator*() {
+            return current_->value;
+        }
+
+        const T* operator->() const {
+            return &current_->value;
+        }
+
+        template <bool c = constant, typename = std::enable_if_t<!c>>
+        T* operator->() {
+            return &current_->value;
+        }
+    };
+
+   public:
+    using value_type = T;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // Constructors and Assignment operators
+
+    explicit StableArrayLinkedList(size_t node_size = s_default_node_size_) :
+        slots_(node_size),
+        free_list_(nullptr),
+        size_(0) {}
+
+    // Handles point into the slots of a list, so copies could not be accessed with them
+    StableArrayLinkedList(const StableArrayLinkedList<T>& other) = delete;
+    StableArrayLinkedList<T>& operator=(const StableArrayLinkedList<T>& other) = delete;
+
+    // Moving keeps the nodes, so handles stay valid and refer to the moved to list afterwards
+    StableArrayLinkedList(StableArrayLinkedList<T>&& other) :
+        slots_(std::move(other.slots_)),
+        free_list_(other.free_list_),
+        size_(other.size_) {
+        other.free_list_ = nullptr;
+        other.size_ = 0;
+    }
+
+    /*
+    The items of this list are erased and its slots are handed to other instead of being freed, so handles to them
+    are detected as stale as long as other exists
+    */
+    StableArrayLinkedList<T>& operator=(StableArrayLinkedList<T>&& other) {
+        if (this != &other) {
+            clear();
+            std::swap(slots_, other.slots_);
+            std::swap(free_list_, other.free_list_);
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // Getters
+
+    size_t node_size() const {
+        return slots_.node_size();
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    // Returns true if the item the handle refers to has not been erased
+    bool contains(Handle handle) const {
+        return handle.slot_ != nullptr && handle.slot_->alive && handle.slot_->generation == handle.generation_;
+    }
+
+    // Returns a pointer to the item the handle refers to or nullptr if the handle is stale
+    T* get(Handle handle) {
+        return contains(handle) ? &handle.slot_->value : nullptr;
+    }
+
+    const T* get(Handle handle) const {
+        return contains(handle) ? &handle.slot_->value : nullptr;
+    }
+
+    // Functions for getting iterators
+
+    iterator begin() noexcept {
+        return iterator(slots_.begin(), slots_.end());
+    }
+
+    iterator end() noexcept {
+        return iterator(slots_.end(), slots_.end());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return const_iterator(slots_.cbegin(), slots_.cend());
+    }
+
+    const_iterator cend() const noexcept {
+        return const_iterator(slots_.cend(), slots_.cend());
+    }
+
+    const_iterator begin() const noexcept {
+        return cbegin();
+    }
+
+    const_iterator end() const noexcept {
+        return cend();
+    }
+
+    // Functions that add items
+
+   private:
+    /*
+    Implements logic for inserting a new item. The actual insertion is passed as a function that takes the slot
+    the item is to be written to, so free slots are reused the same way for all insertion functions
+    */
+    template <typename Function>
+    Handle insert_template(Function func) {
+        Slot* slot;
+        if (free_list_ != nullptr) {
+            slot = free_list_;
+            func(slot->value);
+            free_list_ = slot->next_free;
+            slot->next_free = nullptr;
+        } else {
+            slot = &slots_.emplace_back();
+            try {
+                func(slot->value);
+            } catch (...) {
+                slots_.pop_back();
+                throw;
+            }
+        }
+
+        slot->alive = true;
+        ++size_;
+        return Handle(slot, slot->generation);
+    }
+
+   public:
+    Handle insert(const T& key) {
+        return insert_template([&](T& value) {
+            value = key;
+        });
+    }
+
+    Handle insert(T&& key) {
+        return insert_template([&](T& value) {
+            value = std::move(key);
+        });
+    }
+
+    template <typename... Args>
+    Handle emplace(Args&&... args) {
+        return insert_template([&](T& value) {
+            value = T(std::forward<Args>(args)...);
+        });
+    }
+
+    // Deletion functions
+
+    /*
+    Erases the item the handle refers to without moving any other item, so all other handles and iterators stay valid.
+    Returns false if the handle was already stale
+    */
+    bool erase(Handle handle) {
+        if (!contains(handle))
+            return false;
+
+        Slot* slot = handle.slot_;
+        slot->value = T();
+        slot->alive = false;
+        ++slot->generation;
+        slot->next_free = free_list_;
+        free_list_ = slot;
+        --size_;
+        return true;
+    }
+
+    // Erases every item. The slots are kept as free slots, so handles to the erased items are detected as stale
+    void clear() {
+        free_list_ = nullptr;
+        for (Slot& slot : slots_) {
+            if (slot.alive) {
+                slot.value = T();
+                slot.alive = false;
+                ++slot.generation;
+            }
+            slot.next_free = free_list_;
+            free_list_ = &slot;
+        }
+        size_ = 0;
+    }
+};
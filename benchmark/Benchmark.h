@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+// Helpers shared by the benchmarks, which are plain executables printing their results
+
+// Returns the shortest time in nanoseconds of repetitions calls of func
+template <typename Function>
+double best_time_ns(int repetitions, Function func) {
+    double best = 0;
+    for (int i = 0; i < repetitions; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (i == 0 || time < best)
+            best = time;
+    }
+    return best;
+}
+
+// Returns the command line argument at index as a number, or default_value if it was not given
+inline size_t argument(int argc, char** argv, int index, size_t default_value) {
+    if (index >= argc)
+        return default_value;
+    return std::stoull(argv[index]);
+}
+
+// Keeps the compiler from removing the computation of value
+template <typename T>
+void keep(const T& value) {
+    static volatile T sink;
+    sink = value;
+    (void)sink;
+}
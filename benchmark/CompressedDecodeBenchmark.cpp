@@ -0,0 +1,73 @@
+/*
+Measures scanning monotone ids stored in an ArrayLinkedList and in a CompressedArrayLinkedList (whose for_each_segment
+decodes every sealed node), and finding one of them. Building it with COMPRESSED_ARRAY_LINKED_LIST_NO_SIMD defined
+measures the scalar decoding instead.
+ArrayLinkedListCompressedDecodeBenchmark [key count in millions (default 32)] [node size (default 128)] [largest gap (default 1000)]
+*/
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "../ArrayLinkedList.h"
+#include "../CompressedArrayLinkedList.h"
+#include "Benchmark.h"
+
+template <typename T>
+void run(size_t key_count, size_t node_size, size_t largest_gap) {
+    ArrayLinkedList<T> plain(node_size);
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<size_t> gaps(0, largest_gap);
+    T key = 0;
+    for (size_t i = 0; i < key_count; ++i) {
+        key = static_cast<T>(key + gaps(random));
+        plain.push_back(key);
+    }
+    CompressedArrayLinkedList<T> compressed(plain);
+    const auto& const_plain = plain;
+
+    double plain_scan = best_time_ns(5, [&]() {
+        T sum = 0;
+        for (T key : const_plain)
+            sum = static_cast<T>(sum + key);
+        keep(sum);
+    });
+    double compressed_scan = best_time_ns(5, [&]() {
+        T sum = 0;
+        compressed.for_each_segment([&](const T* keys, size_t size) {
+            for (size_t i = 0; i < size; ++i)
+                sum = static_cast<T>(sum + keys[i]);
+        });
+        keep(sum);
+    });
+
+    // A key in the middle, so find has to skip half of the nodes by their smallest and largest keys
+    T middle = plain.at(key_count / 2);
+    double plain_find = best_time_ns(5, [&]() {
+        keep(*const_plain.find(middle));
+    });
+    double compressed_find = best_time_ns(5, [&]() {
+        keep(*compressed.find(middle));
+    });
+
+    std::printf("uint%zu_t: %zu MB plain, %zu MB compressed\n", sizeof(T) * 8, key_count * sizeof(T) / 1000000,
+        compressed.memory_usage() / 1000000);
+    std::printf("  scan:  %.3f ns per key plain, %.3f ns per key compressed\n", plain_scan / key_count, compressed_scan / key_count);
+    std::printf("  find:  %.0f us plain, %.0f us compressed\n", plain_find / 1000, compressed_find / 1000);
+}
+
+int main(int argc, char** argv) {
+    size_t key_count = argument(argc, argv, 1, 32) * 1000000;
+    size_t node_size = argument(argc, argv, 2, 128);
+    size_t largest_gap = argument(argc, argv, 3, 1000);
+
+#if defined(COMPRESSED_ARRAY_LINKED_LIST_AVX2)
+    std::printf("AVX2 decoding\n");
+#elif defined(COMPRESSED_ARRAY_LINKED_LIST_SSE2)
+    std::printf("SSE2 decoding\n");
+#else
+    std::printf("scalar decoding\n");
+#endif
+    run<uint32_t>(key_count, node_size, largest_gap);
+    run<uint64_t>(key_count, node_size, largest_gap);
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+Measures how appending from several threads scales, for ConcurrentArrayLinkedList and for an ArrayLinkedList guarded
+by a mutex. The thread count doubles from 1 up to the given maximum, the total number of appends stays the same.
+ArrayLinkedListConcurrentAppendBenchmark [appends in millions (default 16)] [maximum threads (default 64)] [node size (default 1024)]
+*/
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../ArrayLinkedList.h"
+#include "../ConcurrentArrayLinkedList.h"
+#include "Benchmark.h"
+
+// Runs append(thread, count) on thread_count threads, which together append total keys
+template <typename Append>
+void run_threads(size_t thread_count, size_t total, Append append) {
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < thread_count; ++thread) {
+        size_t count = total / thread_count + (thread < total % thread_count ? 1 : 0);
+        threads.emplace_back(append, thread, count);
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+int main(int argc, char** argv) {
+    size_t total = argument(argc, argv, 1, 16) * 1000000;
+    size_t max_threads = argument(argc, argv, 2, 64);
+    size_t node_size = argument(argc, argv, 3, 1024);
+
+    std::printf("%zu appends, node size %zu, %u hardware threads\n", total, node_size, std::thread::hardware_concurrency());
+    std::printf("threads  concurrent (M appends/s)  mutex (M appends/s)\n");
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+        double concurrent = best_time_ns(3, [&]() {
+            ConcurrentArrayLinkedList<uint64_t> list(node_size);
+            run_threads(thread_count, total, [&](size_t thread, size_t count) {
+                for (size_t i = 0; i < count; ++i)
+                    list.push_back(thread << 32 | i);
+            });
+        });
+
+        double locked = best_time_ns(3, [&]() {
+            ArrayLinkedList<uint64_t> list(node_size);
+            std::mutex mutex;
+            run_threads(thread_count, total, [&](size_t thread, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    list.push_back(thread << 32 | i);
+                }
+            });
+        });
+
+        std::printf("%7zu  %24.1f  %19.1f\n", thread_count, total / concurrent * 1000, total / locked * 1000);
+    }
+    return 0;
+}
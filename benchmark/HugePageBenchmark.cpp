@@ -0,0 +1,123 @@
+/*
+Measures iteration and find over a large list whose nodes come from std::allocator and from HugePageAllocator, and counts
+the dTLB load misses of each run with a perf counter (linux only, perf_event_paranoid may have to be lowered to allow it).
+ArrayLinkedListHugePageBenchmark [list size in MB (default 1024)] [node size (default 64)]
+*/
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../ArrayLinkedList.h"
+#include "../HugePageAllocator.h"
+#include "Benchmark.h"
+
+// Counts the dTLB load misses of this thread between start() and stop(), if the kernel allows it
+class DtlbMissCounter {
+    int fd_;
+
+   public:
+    DtlbMissCounter() :
+        fd_(-1) {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    DtlbMissCounter(const DtlbMissCounter& other) = delete;
+    DtlbMissCounter& operator=(const DtlbMissCounter& other) = delete;
+
+    ~DtlbMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0)
+            close(fd_);
+#endif
+    }
+
+    bool available() const {
+        return fd_ >= 0;
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count))
+                count = 0;
+        }
+#endif
+        return count;
+    }
+};
+
+template <typename Allocator>
+void run(const char* name, size_t key_count, size_t node_size, const Allocator& allocator, DtlbMissCounter& counter) {
+    ArrayLinkedList<uint64_t, Allocator> list(node_size, allocator);
+    for (size_t i = 0; i < key_count; ++i)
+        list.push_back(i);
+    const auto& const_list = list;
+
+    uint64_t iterate_misses = 0;
+    double iterate = best_time_ns(3, [&]() {
+        counter.start();
+        uint64_t sum = 0;
+        for (uint64_t key : const_list)
+            sum += key;
+        iterate_misses = counter.stop();
+        keep(sum);
+    });
+
+    uint64_t find_misses = 0;
+    double find = best_time_ns(3, [&]() {
+        counter.start();
+        keep(const_list.find(key_count) == const_list.end());
+        find_misses = counter.stop();
+    });
+
+    std::printf("%-18s iterate: %.3f ns per key", name, iterate / key_count);
+    if (counter.available())
+        std::printf(", %.3f dTLB misses per 1000 keys", iterate_misses * 1000.0 / key_count);
+    std::printf("\n%-18s find:    %.3f ns per key", "", find / key_count);
+    if (counter.available())
+        std::printf(", %.3f dTLB misses per 1000 keys", find_misses * 1000.0 / key_count);
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    size_t key_count = argument(argc, argv, 1, 1024) * 1024 * 1024 / sizeof(uint64_t);
+    size_t node_size = argument(argc, argv, 2, 64);
+
+    DtlbMissCounter counter;
+    std::printf("%zu keys, node size %zu\n", key_count, node_size);
+    if (!counter.available())
+        std::printf("dTLB misses are not reported, the perf counter could not be opened\n");
+
+    run("std::allocator", key_count, node_size, std::allocator<uint64_t>(), counter);
+    run("HugePageAllocator", key_count, node_size, HugePageAllocator<uint64_t>(), counter);
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+Measures traversals of a list that is larger than the last level cache and whose nodes are scattered over memory in random
+order, so every step to the next node misses the cache unless it was prefetched.
+The build creates one executable per prefetch distance (see CMakeLists.txt), which are run with the same arguments:
+ArrayLinkedListTraversalBenchmark<distance> [key count in millions (default 32)] [node size (default 64)]
+*/
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../ArrayLinkedList.h"
+#include "Benchmark.h"
+
+// Fixed size blocks of one large buffer, which are handed out in random order
+class ShuffledPool {
+    size_t block_size_;
+    size_t block_count_;
+    char* memory_;
+    std::vector<size_t> order_;
+    size_t next_;
+
+   public:
+    ShuffledPool(size_t block_size, size_t block_count) :
+        block_size_((block_size + 63) / 64 * 64),
+        block_count_(block_count),
+        memory_(static_cast<char*>(::operator new(block_size_ * block_count_, std::align_val_t(64)))),
+        order_(block_count),
+        next_(0) {
+        std::iota(order_.begin(), order_.end(), size_t(0));
+        std::shuffle(order_.begin(), order_.end(), std::mt19937_64(42));
+    }
+
+    ShuffledPool(const ShuffledPool& other) = delete;
+    ShuffledPool& operator=(const ShuffledPool& other) = delete;
+
+    ~ShuffledPool() {
+        ::operator delete(memory_, std::align_val_t(64));
+    }
+
+    void* allocate(size_t size) {
+        if (size > block_size_ || next_ == block_count_)
+            throw std::bad_alloc();
+        return memory_ + order_[next_++] * block_size_;
+    }
+};
+
+// Allocates every node and keys block from a ShuffledPool, freed blocks are not reused
+template <typename T>
+class ShuffledAllocator {
+    template <typename U>
+    friend class ShuffledAllocator;
+
+    std::shared_ptr<ShuffledPool> pool_;
+
+   public:
+    using value_type = T;
+
+    explicit ShuffledAllocator(std::shared_ptr<ShuffledPool> pool) :
+        pool_(std::move(pool)) {}
+
+    template <typename U>
+    ShuffledAllocator(const ShuffledAllocator<U>& other) :
+        pool_(other.pool_) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(pool_->allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ShuffledAllocator<U>& other) const {
+        return pool_ == other.pool_;
+    }
+
+    template <typename U>
+    bool operator!=(const ShuffledAllocator<U>& other) const {
+        return pool_ != other.pool_;
+    }
+};
+
+int main(int argc, char** argv) {
+    size_t key_count = argument(argc, argv, 1, 32) * 1000000;
+    size_t node_size = argument(argc, argv, 2, 64);
+    size_t node_count = (key_count + node_size - 1) / node_size;
+
+    // Every node takes two blocks, one for the node and one for its keys
+    auto pool = std::make_shared<ShuffledPool>(std::max(node_size * sizeof(uint64_t), size_t(64)), node_count * 2);
+    ArrayLinkedList<uint64_t, ShuffledAllocator<uint64_t>> list(node_size, ShuffledAllocator<uint64_t>(pool));
+    for (size_t i = 0; i < key_count; ++i)
+        list.push_back(i);
+
+    const auto& const_list = list;
+    double iterate = best_time_ns(5, [&]() {
+        uint64_t sum = 0;
+        for (uint64_t key : const_list)
+            sum += key;
+        keep(sum);
+    });
+    double find = best_time_ns(5, [&]() {
+        keep(const_list.find(key_count) == const_list.end());
+    });
+
+    std::printf("prefetch distance %zu, %zu keys (%zu MB), node size %zu\n", size_t(ARRAY_LINKED_LIST_PREFETCH_DISTANCE),
+        key_count, key_count * sizeof(uint64_t) / 1000000, node_size);
+    std::printf("iterate: %.3f ns per key\n", iterate / key_count);
+    std::printf("find:    %.3f ns per key\n", find / key_count);
+    return 0;
+}
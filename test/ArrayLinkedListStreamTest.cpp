@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "../ArrayLinkedListStream.h"
+
+TEST(ArrayLinkedListStreamTest, ProducerConsumer) {
+    ArrayLinkedListStream<int> stream(10, 2);
+    const int item_count = 1005;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < item_count; ++i)
+            stream.push(i);
+        stream.close();
+    });
+
+    int expected = 0;
+    size_t segment_count = 0;
+    while (auto segment = stream.next_segment()) {
+        EXPECT_LE(segment->size(), 10);
+        for (const int& key : *segment) {
+            EXPECT_EQ(key, expected);
+            ++expected;
+        }
+        ++segment_count;
+    }
+    producer.join();
+
+    EXPECT_EQ(expected, item_count);
+    EXPECT_EQ(segment_count, 101);
+    EXPECT_FALSE(stream.next_segment().has_value());
+}
+
+TEST(ArrayLinkedListStreamTest, Backpressure) {
+    ArrayLinkedListStream<int> stream(1, 3);
+    std::atomic<int> pushed = 0;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < 10; ++i) {
+            stream.push(i);
+            ++pushed;
+        }
+        stream.close();
+    });
+
+    // The producer has to stop once 3 segments are pending
+    while (pushed.load() < 3)
+        std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(pushed.load(), 3);
+
+    int expected = 0;
+    while (auto segment = stream.next_segment()) {
+        EXPECT_EQ(segment->front(), expected);
+        ++expected;
+    }
+    producer.join();
+    EXPECT_EQ(expected, 10);
+}
+
+#if defined(ARRAY_LINKED_LIST_STREAM_REQUIRE_COROUTINES) && !defined(ARRAY_LINKED_LIST_STREAM_COROUTINES)
+#error "The coroutine test target has to be compiled with coroutine support"
+#endif
+
+#ifdef ARRAY_LINKED_LIST_STREAM_COROUTINES
+// Coroutine that starts eagerly and is destroyed by its owner
+struct ConsumerTask {
+    struct promise_type {
+        ConsumerTask get_return_object() {
+            return ConsumerTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_never initial_suspend() {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+
+    ~ConsumerTask() {
+        handle.destroy();
+    }
+};
+
+ConsumerTask consume(ArrayLinkedListStream<int>& stream, std::vector<int>& result) {
+    while (auto segment = co_await stream.next_segment_async()) {
+        for (const int& key : *segment)
+            result.push_back(key);
+    }
+}
+
+TEST(ArrayLinkedListStreamTest, Coroutine) {
+    ArrayLinkedListStream<int> stream(4);
+    std::vector<int> result;
+    ConsumerTask task = consume(stream, result);
+
+    // The consumer is resumed by push as soon as a node is full
+    for (int i = 0; i < 3; ++i)
+        stream.push(i);
+    EXPECT_TRUE(result.empty());
+    stream.push(3);
+    EXPECT_EQ(result.size(), 4);
+
+    stream.push(4);
+    stream.close();
+    EXPECT_EQ(result.size(), 5);
+    EXPECT_TRUE(task.handle.done());
+}
+
+TEST(ArrayLinkedListStreamTest, SpanGenerator) {
+    ArrayLinkedListStream<int> stream(8, 2);
+    const int item_count = 100;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < item_count; ++i)
+            stream.push(i);
+        stream.close();
+    });
+
+    int expected = 0;
+    size_t span_count = 0;
+    for (const auto& span : stream.spans()) {
+        EXPECT_LE(span.size(), 8);
+        for (const int& key : span) {
+            EXPECT_EQ(key, expected);
+            ++expected;
+        }
+        ++span_count;
+    }
+    producer.join();
+
+    EXPECT_EQ(expected, item_count);
+    EXPECT_EQ(span_count, 13);
+
+    // A closed stream yields no spans
+    auto spans = stream.spans();
+    EXPECT_EQ(spans.begin(), spans.end());
+}
+#endif
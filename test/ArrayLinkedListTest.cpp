@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+
 #include "../ArrayLinkedList.h"
 
 struct ArrayLinkedListTest : public testing::Test {
@@ -423,4 +429,711 @@ TEST_F(ArrayLinkedListTest, InitializerList) {
 
     EXPECT_EQ(init_list_it, init_list.end());
     EXPECT_EQ(list_it, list.end());
-}
\ No newline at end of file
+}
+
+TEST_F(ArrayLinkedListTest, Serialization) {
+    std::stringstream stream;
+    list.serialize(stream);
+
+    ArrayLinkedList<int> deserialized = ArrayLinkedList<int>::deserialize(stream);
+    EXPECT_EQ(deserialized.node_size(), list.node_size());
+    EXPECT_EQ(deserialized.size(), list.size());
+    forward_iterator_test<ArrayLinkedList<int>::iterator>(deserialized,
+    [](ArrayLinkedList<int>& param) {
+        return param.begin();
+    },
+    [](ArrayLinkedList<int>& param) {
+        return param.end();
+    });
+
+    std::string data = stream.str();
+    auto view = ArrayLinkedList<int>::view(data.data(), data.size());
+    EXPECT_EQ(view.size(), list.size());
+    EXPECT_EQ(view.node_size(), list.node_size());
+
+    auto list_it = list.begin();
+    for (const int& key : view) {
+        EXPECT_EQ(key, *list_it);
+        ++list_it;
+    }
+    EXPECT_EQ(list_it, list.end());
+
+    // Truncated data must be rejected
+    EXPECT_THROW(ArrayLinkedList<int>::view(data.data(), data.size() - 1), std::runtime_error);
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_THROW(ArrayLinkedList<int>::deserialize(truncated), std::runtime_error);
+
+    // Lists of other element types must be rejected
+    std::stringstream wrong_type(data);
+    EXPECT_THROW(ArrayLinkedList<int64_t>::deserialize(wrong_type), std::runtime_error);
+
+    // Types of the same size are told apart
+    ArrayLinkedList<float> floats = {1.0f, 2.0f};
+    std::stringstream float_stream;
+    floats.serialize(float_stream);
+    std::string float_data = float_stream.str();
+    EXPECT_THROW(ArrayLinkedList<int>::deserialize(float_stream), std::runtime_error);
+    EXPECT_THROW(ArrayLinkedList<int>::view(float_data.data(), float_data.size()), std::runtime_error);
+    std::stringstream unsigned_stream(data);
+    EXPECT_THROW(ArrayLinkedList<unsigned int>::deserialize(unsigned_stream), std::runtime_error);
+
+    // Data written with a different byte order is rejected
+    std::string swapped = data;
+    std::reverse(swapped.begin() + 8, swapped.begin() + 16);
+    EXPECT_THROW(ArrayLinkedList<int>::view(swapped.data(), swapped.size()), std::runtime_error);
+
+    ArrayLinkedList<int> empty;
+    std::stringstream empty_stream;
+    empty.serialize(empty_stream);
+    EXPECT_TRUE(ArrayLinkedList<int>::deserialize(empty_stream).empty());
+}
+
+struct alignas(16) AlignedKey {
+    int64_t low;
+    int64_t high;
+};
+
+TEST_F(ArrayLinkedListTest, SerializationOverAligned) {
+    ArrayLinkedList<AlignedKey> aligned(4);
+    for (int64_t i = 0; i < 10; ++i)
+        aligned.push_back({i, -i});
+    std::stringstream stream;
+    aligned.serialize(stream);
+    std::string data = stream.str();
+
+    // The keys of data copied to a buffer aligned to 64 bytes are aligned for the key type
+    struct alignas(64) Block {
+        char bytes[64];
+    };
+    std::vector<Block> buffer(data.size() / sizeof(Block) + 1);
+    std::memcpy(buffer.data(), data.data(), data.size());
+    auto view = ArrayLinkedList<AlignedKey>::view(buffer.data(), data.size());
+    ASSERT_EQ(view.size(), 10);
+    for (int64_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(view.at(i).low, i);
+        EXPECT_EQ(view.at(i).high, -i);
+    }
+
+    ArrayLinkedList<long double> long_doubles = {1.5L, 2.5L};
+    std::stringstream long_double_stream;
+    long_doubles.serialize(long_double_stream);
+    std::string long_double_data = long_double_stream.str();
+    std::memcpy(buffer.data(), long_double_data.data(), long_double_data.size());
+    auto long_double_view = ArrayLinkedList<long double>::view(buffer.data(), long_double_data.size());
+    ASSERT_EQ(long_double_view.size(), 2);
+    EXPECT_EQ(long_double_view.at(1), 2.5L);
+}
+
+TEST_F(ArrayLinkedListTest, EraseRange) {
+    // Remove the second run of 0 - 49 so the items of different nodes have to be moved
+    auto first = list.begin();
+    for (int i = 0; i < 30; ++i)
+        ++first;
+    auto last = first;
+    for (int i = 0; i < 40; ++i)
+        ++last;
+
+    auto after_it = list.erase(first, last);
+    EXPECT_EQ(list.size(), 61);
+    EXPECT_EQ(*after_it, 20);
+
+    auto it = list.begin();
+    for (int i = 0; i < 30; ++i) {
+        EXPECT_EQ(*it, i);
+        ++it;
+    }
+    for (int i = 20; i < 50; ++i) {
+        EXPECT_EQ(*it, i);
+        ++it;
+    }
+    EXPECT_EQ(*it, 10000);
+    ++it;
+    EXPECT_EQ(it, list.end());
+
+    // Erasing an empty range does nothing
+    EXPECT_EQ(list.erase(list.begin(), list.begin()), list.begin());
+    EXPECT_EQ(list.size(), 61);
+
+    // Erasing everything up to the end returns end()
+    auto cfirst = list.cbegin();
+    ++cfirst;
+    EXPECT_EQ(list.erase(cfirst, list.cend()), list.cend());
+    EXPECT_EQ(list.size(), 1);
+    EXPECT_EQ(list.back(), 0);
+
+    EXPECT_EQ(list.erase(list.begin(), list.end()), list.end());
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST_F(ArrayLinkedListTest, EraseIf) {
+    size_t removed = list.erase_if([](int key) {
+        return key % 2 == 1;
+    });
+    EXPECT_EQ(removed, 50);
+    EXPECT_EQ(list.size(), 51);
+
+    auto it = list.begin();
+    for (int run = 0; run < 2; ++run) {
+        for (int i = 0; i < 50; i += 2) {
+            EXPECT_EQ(*it, i);
+            ++it;
+        }
+    }
+    EXPECT_EQ(*it, 10000);
+    ++it;
+    EXPECT_EQ(it, list.end());
+
+    EXPECT_EQ(list.remove(list.front()), 2);
+    EXPECT_EQ(list.size(), 49);
+    EXPECT_FALSE(list.contains(0));
+    EXPECT_EQ(list.remove(0), 0);
+
+    EXPECT_EQ(list.erase_if([](int) {
+        return true;
+    }), 49);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST_F(ArrayLinkedListTest, Snapshot) {
+    ArrayLinkedList<int> snapshot = list.snapshot();
+    const ArrayLinkedList<int>& const_snapshot = snapshot;
+    EXPECT_EQ(snapshot.size(), list.size());
+    EXPECT_EQ(&*const_snapshot.cbegin(), &*static_cast<const ArrayLinkedList<int>&>(list).cbegin());
+
+    // Changing the original must not change the snapshot
+    for (int& key : list)
+        key = -1;
+    list.push_back(-1);
+
+    auto it = const_snapshot.cbegin();
+    for (int run = 0; run < 2; ++run) {
+        for (int i = 0; i < 50; ++i) {
+            EXPECT_EQ(*it, i);
+            ++it;
+        }
+    }
+    EXPECT_EQ(*it, 10000);
+    ++it;
+    EXPECT_EQ(it, const_snapshot.cend());
+
+    for (const int& key : static_cast<const ArrayLinkedList<int>&>(list))
+        EXPECT_EQ(key, -1);
+
+    // Changing a snapshot must neither change the original nor other snapshots
+    ArrayLinkedList<int> second_snapshot = snapshot.snapshot();
+    snapshot.erase(snapshot.begin());
+    EXPECT_EQ(snapshot.size(), 100);
+    EXPECT_EQ(snapshot.front(), 1);
+    EXPECT_EQ(second_snapshot.size(), 101);
+    forward_iterator_test<ArrayLinkedList<int>::iterator>(second_snapshot,
+    [](ArrayLinkedList<int>& param) {
+        return param.begin();
+    },
+    [](ArrayLinkedList<int>& param) {
+        return param.end();
+    });
+
+    // Snapshots outlive the list they were taken from
+    ArrayLinkedList<int>* temporary = new ArrayLinkedList<int>(second_snapshot);
+    ArrayLinkedList<int> third_snapshot = temporary->snapshot();
+    delete temporary;
+    EXPECT_EQ(third_snapshot.size(), 101);
+    EXPECT_EQ(third_snapshot.back(), 10000);
+
+    // Assigning to a list that shares its nodes
+    ArrayLinkedList<int> fourth_snapshot = third_snapshot.snapshot();
+    third_snapshot = list;
+    EXPECT_EQ(third_snapshot.front(), -1);
+    EXPECT_EQ(fourth_snapshot.front(), 0);
+
+    EXPECT_TRUE(ArrayLinkedList<int>().snapshot().empty());
+}
+
+TEST_F(ArrayLinkedListTest, ConcurrentSnapshots) {
+    const ArrayLinkedList<int>& const_list = list;
+    std::vector<std::vector<ArrayLinkedList<int>>> snapshots(4);
+    std::vector<std::thread> threads;
+    for (auto& thread_snapshots : snapshots) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 100; ++i)
+                thread_snapshots.push_back(const_list.snapshot());
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // All snapshots have to share a single count, a count lost in a race would be leaked
+    list.push_back(-1);
+    for (const auto& thread_snapshots : snapshots) {
+        for (const ArrayLinkedList<int>& snapshot : thread_snapshots) {
+            EXPECT_EQ(snapshot.size(), 101);
+            EXPECT_EQ(snapshot.back(), 10000);
+        }
+    }
+}
+
+TEST_F(ArrayLinkedListTest, SnapshotAppend) {
+    const ArrayLinkedList<int>& const_list = list;
+    ArrayLinkedList<int> snapshot = list.snapshot();
+    const ArrayLinkedList<int>& const_snapshot = snapshot;
+
+    // Appending to the list writes behind the end of the snapshot, so the nodes stay shared
+    for (int i = 0; i < 120; ++i)
+        list.push_back(20000 + i);
+    EXPECT_EQ(list.emplace_back(30000), 30000);
+    EXPECT_EQ(&*const_list.cbegin(), &*const_snapshot.cbegin());
+    EXPECT_EQ(list.size(), 222);
+    EXPECT_EQ(const_list.back(), 30000);
+
+    // The snapshot does not see the appended items
+    EXPECT_EQ(snapshot.size(), 101);
+    EXPECT_EQ(const_snapshot.find(20000), const_snapshot.cend());
+    EXPECT_EQ(const_snapshot.find_many({20000, 10000})[0], const_snapshot.cend());
+    size_t count = 0;
+    for (auto it = const_snapshot.cbegin(); it != const_snapshot.cend(); ++it)
+        ++count;
+    EXPECT_EQ(count, 101);
+    EXPECT_EQ(ArrayLinkedList<int>(snapshot).size(), 101);
+
+    // Appending to the shorter snapshot has to copy, as it would overwrite items of the list
+    ArrayLinkedList<int> second_snapshot = snapshot.snapshot();
+    snapshot.push_back(-1);
+    EXPECT_NE(&*const_list.cbegin(), &*const_snapshot.cbegin());
+    EXPECT_EQ(snapshot.size(), 102);
+    EXPECT_EQ(const_snapshot.back(), -1);
+    EXPECT_EQ(const_list.at(101), 20000);
+    EXPECT_EQ(static_cast<const ArrayLinkedList<int>&>(second_snapshot).back(), 10000);
+
+    // Of two lists with the same size only the first one to append keeps sharing the nodes
+    ArrayLinkedList<int> third_snapshot = list.snapshot();
+    third_snapshot.push_back(1);
+    list.push_back(2);
+    EXPECT_EQ(const_list.back(), 2);
+    EXPECT_EQ(static_cast<const ArrayLinkedList<int>&>(third_snapshot).back(), 1);
+    EXPECT_EQ(list.size(), third_snapshot.size());
+
+    // A list that outlives the longer list sharing its nodes frees the nodes appended by it
+    ArrayLinkedList<int> source(4);
+    for (int i = 0; i < 6; ++i)
+        source.push_back(i);
+    ArrayLinkedList<int> outliving = source.snapshot();
+    for (int i = 6; i < 20; ++i)
+        source.push_back(i);
+    source.clear();
+    outliving.push_back(6);
+    EXPECT_EQ(outliving.size(), 7);
+    EXPECT_EQ(outliving.back(), 6);
+}
+
+TEST_F(ArrayLinkedListTest, SnapshotAppendConcurrently) {
+    ArrayLinkedList<int> snapshot = list.snapshot();
+    const ArrayLinkedList<int>& const_snapshot = snapshot;
+
+    // The snapshot is read while the list keeps appending to the nodes they share
+    std::thread reader([&]() {
+        for (int run = 0; run < 100; ++run) {
+            size_t count = 0;
+            for (auto it = const_snapshot.cbegin(); it != const_snapshot.cend(); ++it)
+                ++count;
+            EXPECT_EQ(count, 101);
+            EXPECT_FALSE(const_snapshot.contains(-1));
+        }
+    });
+    for (int i = 0; i < 10000; ++i)
+        list.push_back(-1);
+    reader.join();
+    EXPECT_EQ(list.size(), 10101);
+}
+
+TEST_F(ArrayLinkedListTest, SnapshotEraseConstIterators) {
+    ArrayLinkedList<int> small(4);
+    for (int i = 0; i < 10; ++i)
+        small.push_back(i);
+    const ArrayLinkedList<int>& const_small = small;
+
+    // Const iterators do not detach, so they still point into the nodes shared with the snapshot when erase is called
+    ArrayLinkedList<int> snapshot = small.snapshot();
+    auto it = small.erase(const_small.cbegin());
+    EXPECT_EQ(*it, 1);
+    EXPECT_EQ(small.size(), 9);
+    EXPECT_EQ(small.front(), 1);
+    EXPECT_EQ(small.back(), 9);
+
+    ArrayLinkedList<int> second_snapshot = small.snapshot();
+    auto first = const_small.cbegin();
+    ++first;
+    auto last = first;
+    for (int i = 0; i < 5; ++i)
+        ++last;
+    it = small.erase(first, last);
+    EXPECT_EQ(*it, 7);
+    EXPECT_EQ(small.size(), 4);
+
+    ArrayLinkedList<int> third_snapshot = small.snapshot();
+    it = small.erase(const_small.cbegin(), const_small.cend());
+    EXPECT_EQ(it, const_small.cend());
+    EXPECT_TRUE(small.empty());
+
+    // The snapshots still hold the keys they were taken with
+    auto keys = [](const ArrayLinkedList<int>& list) {
+        std::vector<int> result;
+        for (auto it = list.cbegin(); it != list.cend(); ++it)
+            result.push_back(*it);
+        return result;
+    };
+    EXPECT_EQ(keys(snapshot), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(keys(second_snapshot), std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(keys(third_snapshot), std::vector<int>({1, 7, 8, 9}));
+}
+
+TEST_F(ArrayLinkedListTest, InlineBuffer) {
+    using SmallList = ArrayLinkedList<int, std::allocator<int>, 4>;
+    SmallList small(10);
+    for (int i = 0; i < 4; ++i)
+        small.push_back(i);
+
+    // The keys are still stored inside the list object
+    EXPECT_GE(&small.front(), reinterpret_cast<int*>(&small));
+    EXPECT_LT(&small.back(), reinterpret_cast<int*>(&small + 1));
+
+    SmallList copy(small);
+    EXPECT_EQ(copy.size(), 4);
+    EXPECT_EQ(copy.back(), 3);
+    EXPECT_GE(&copy.front(), reinterpret_cast<int*>(&copy));
+    EXPECT_LT(&copy.back(), reinterpret_cast<int*>(&copy + 1));
+
+    SmallList moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.at(2), 2);
+
+    // Overflowing the buffer moves the keys to the heap
+    for (int i = 4; i < 25; ++i)
+        small.push_back(i);
+    EXPECT_EQ(small.size(), 25);
+    int expected = 0;
+    for (const int& key : small) {
+        EXPECT_EQ(key, expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 25);
+
+    small.resize(2);
+    EXPECT_EQ(small.size(), 2);
+    EXPECT_EQ(small.back(), 1);
+
+    moved = small;
+    EXPECT_EQ(moved.size(), 2);
+    small = moved.snapshot();
+    EXPECT_EQ(small.size(), 2);
+
+    small.erase(small.begin());
+    small.pop_back();
+    EXPECT_TRUE(small.empty());
+    EXPECT_EQ(small.begin(), small.end());
+    small.resize(3, 7);
+    EXPECT_EQ(small.size(), 3);
+    EXPECT_EQ(small.back(), 7);
+    EXPECT_EQ(moved.front(), 0);
+
+    // Inline capacities larger than the node size are limited to the node size
+    ArrayLinkedList<int, std::allocator<int>, 8> tiny_nodes(2);
+    for (int i = 0; i < 9; ++i)
+        tiny_nodes.push_back(i);
+    for (int i = 0; i < 9; ++i)
+        EXPECT_EQ(tiny_nodes.at(i), i);
+}
+
+TEST_F(ArrayLinkedListTest, InlineBufferPushOwnKey) {
+    // Pushing a key of the full inline buffer copies it before the buffer is moved to the heap
+    ArrayLinkedList<std::string, std::allocator<std::string>, 2> strings(10);
+    strings.push_back("a");
+    strings.push_back("b");
+    strings.push_back(strings.front());
+    EXPECT_EQ(strings.size(), 3);
+    EXPECT_EQ(strings.at(0), "a");
+    EXPECT_EQ(strings.at(1), "b");
+    EXPECT_EQ(strings.back(), "a");
+
+    // The same holds when the key has to go into a second node
+    ArrayLinkedList<std::string, std::allocator<std::string>, 2> full_nodes(2);
+    full_nodes.push_back("a");
+    full_nodes.push_back("b");
+    full_nodes.emplace_back(full_nodes.back());
+    EXPECT_EQ(full_nodes.size(), 3);
+    EXPECT_EQ(full_nodes.at(0), "a");
+    EXPECT_EQ(full_nodes.at(1), "b");
+    EXPECT_EQ(full_nodes.back(), "b");
+}
+
+TEST_F(ArrayLinkedListTest, FindMany) {
+    // Small batches are compared directly, the larger one is looked up in a hash map
+    std::vector<int> small_batch = {10000, 3, -1, 49, 3};
+    std::vector<int> large_batch;
+    for (int i = -10; i < 60; ++i)
+        large_batch.push_back(i);
+    large_batch.push_back(10000);
+    large_batch.push_back(5);
+
+    for (const auto& keys : {small_batch, large_batch}) {
+        auto iterators = list.find_many(keys);
+        auto bitmap = list.contains_many(keys);
+        const auto& const_list = list;
+        auto const_iterators = const_list.find_many(keys);
+        ASSERT_EQ(iterators.size(), keys.size());
+        ASSERT_EQ(bitmap.size(), keys.size());
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            EXPECT_EQ(iterators[i], list.find(keys[i]));
+            EXPECT_EQ(const_iterators[i], const_list.find(keys[i]));
+            EXPECT_EQ(bitmap[i], list.contains(keys[i]));
+        }
+    }
+
+    EXPECT_TRUE(list.find_many({}).empty());
+
+    // Types without a hash function always take the direct comparison path
+    struct Unhashable {
+        int value;
+        bool operator==(const Unhashable& other) const {
+            return value == other.value;
+        }
+    };
+    ArrayLinkedList<Unhashable> unhashable(3);
+    for (int i = 0; i < 10; ++i)
+        unhashable.push_back({i});
+    std::vector<Unhashable> unhashable_keys;
+    for (int i = 0; i < 20; ++i)
+        unhashable_keys.push_back({i});
+    auto bitmap = unhashable.contains_many(unhashable_keys);
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(bitmap[i], i < 10);
+}
+
+/*
+Key that throws from its copy constructor and copy assignment once a given number of copies were made, and counts
+how many instances exist, so the exception safety tests can check that nothing leaks
+*/
+struct ThrowingKey {
+    // Number of copies that succeed before one throws, or -1 to never throw
+    static int s_copies_until_throw;
+    static int s_instances;
+
+    int value;
+
+    ThrowingKey(int value = 0) :
+        value(value) {
+        ++s_instances;
+    }
+
+    ThrowingKey(const ThrowingKey& other) :
+        value(other.value) {
+        count_copy();
+        ++s_instances;
+    }
+
+    ~ThrowingKey() {
+        --s_instances;
+    }
+
+    ThrowingKey& operator=(const ThrowingKey& other) {
+        count_copy();
+        value = other.value;
+        return *this;
+    }
+
+    bool operator==(const ThrowingKey& other) const {
+        return value == other.value;
+    }
+
+    static void count_copy() {
+        if (s_copies_until_throw == 0)
+            throw std::runtime_error("Copy failed");
+        if (s_copies_until_throw > 0)
+            --s_copies_until_throw;
+    }
+};
+
+int ThrowingKey::s_copies_until_throw = -1;
+int ThrowingKey::s_instances = 0;
+
+using ThrowingList = ArrayLinkedList<ThrowingKey>;
+using InlineThrowingList = ArrayLinkedList<ThrowingKey, std::allocator<ThrowingKey>, 4>;
+
+template <typename List>
+static std::vector<int> values(const List& list) {
+    std::vector<int> result;
+    for (auto it = list.cbegin(); it != list.cend(); ++it)
+        result.push_back(it->value);
+    return result;
+}
+
+template <typename List = ThrowingList>
+static List make_throwing_list(int size, int first_value) {
+    List list(5);
+    for (int i = 0; i < size; ++i)
+        list.emplace_back(first_value + i);
+    return list;
+}
+
+/*
+Calls operation with a copy failing at every possible position, until it succeeds without throwing. After every failure
+the lists returned by get_lists must have the values they had before, and no keys may have been leaked
+*/
+template <typename Operation, typename GetLists>
+void fault_injection_test(Operation operation, GetLists get_lists) {
+    std::vector<std::vector<int>> expected;
+    for (const auto* list : get_lists())
+        expected.push_back(values(*list));
+    int instances = ThrowingKey::s_instances;
+
+    for (int copies = 0;; ++copies) {
+        ThrowingKey::s_copies_until_throw = copies;
+        bool thrown = false;
+        try {
+            operation();
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        ThrowingKey::s_copies_until_throw = -1;
+        if (!thrown)
+            break;
+
+        auto lists = get_lists();
+        for (size_t i = 0; i < lists.size(); ++i)
+            EXPECT_EQ(values(*lists[i]), expected[i]);
+        EXPECT_EQ(ThrowingKey::s_instances, instances);
+    }
+}
+
+TEST_F(ArrayLinkedListTest, ExceptionSafetyCopy) {
+    {
+        ThrowingList source = make_throwing_list(23, 0);
+        fault_injection_test([&]() {
+            ThrowingList copy(source);
+        }, [&]() {
+            return std::vector<const ThrowingList*>{&source};
+        });
+
+        // Assigning a longer and a shorter list
+        ThrowingList target = make_throwing_list(12, 100);
+        fault_injection_test([&]() {
+            target = source;
+        }, [&]() {
+            return std::vector<const ThrowingList*>{&source, &target};
+        });
+        EXPECT_EQ(values(target), values(source));
+
+        ThrowingList shorter = make_throwing_list(3, 200);
+        fault_injection_test([&]() {
+            target = shorter;
+        }, [&]() {
+            return std::vector<const ThrowingList*>{&shorter, &target};
+        });
+        EXPECT_EQ(values(target), values(shorter));
+
+        // Changing a list that shares its nodes with a snapshot copies the nodes first
+        fault_injection_test([&]() {
+            ThrowingList snapshot = source.snapshot();
+            snapshot.push_back(ThrowingKey(-1));
+        }, [&]() {
+            return std::vector<const ThrowingList*>{&source};
+        });
+    }
+    EXPECT_EQ(ThrowingKey::s_instances, 0);
+
+    // Copying empty lists
+    ThrowingList empty(5);
+    ThrowingList list = make_throwing_list(7, 0);
+    list = empty;
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+    list.emplace_back(1);
+    EXPECT_EQ(values(list), std::vector<int>{1});
+}
+
+TEST_F(ArrayLinkedListTest, ExceptionSafetyInlineCopy) {
+    {
+        InlineThrowingList source = make_throwing_list<InlineThrowingList>(3, 0);
+        fault_injection_test([&]() {
+            InlineThrowingList copy(source);
+        }, [&]() {
+            return std::vector<const InlineThrowingList*>{&source};
+        });
+
+        // Assigning an inline list to an inline list, to a list on the heap and back
+        InlineThrowingList target = make_throwing_list<InlineThrowingList>(2, 100);
+        fault_injection_test([&]() {
+            target = source;
+        }, [&]() {
+            return std::vector<const InlineThrowingList*>{&source, &target};
+        });
+        EXPECT_EQ(values(target), values(source));
+
+        InlineThrowingList heap = make_throwing_list<InlineThrowingList>(12, 200);
+        fault_injection_test([&]() {
+            heap = source;
+        }, [&]() {
+            return std::vector<const InlineThrowingList*>{&source, &heap};
+        });
+        EXPECT_EQ(values(heap), values(source));
+
+        InlineThrowingList longer = make_throwing_list<InlineThrowingList>(12, 300);
+        fault_injection_test([&]() {
+            target = longer;
+        }, [&]() {
+            return std::vector<const InlineThrowingList*>{&longer, &target};
+        });
+        EXPECT_EQ(values(target), values(longer));
+
+        // Overflowing the inline buffer
+        InlineThrowingList full = make_throwing_list<InlineThrowingList>(4, 0);
+        ThrowingKey key(4);
+        fault_injection_test([&]() {
+            full.push_back(key);
+        }, [&]() {
+            return std::vector<const InlineThrowingList*>{&full};
+        });
+        EXPECT_EQ(values(full), std::vector<int>({0, 1, 2, 3, 4}));
+    }
+    EXPECT_EQ(ThrowingKey::s_instances, 0);
+}
+
+TEST_F(ArrayLinkedListTest, ExceptionSafetyInsert) {
+    {
+        // The tail node is full, so the key goes into a new node
+        ThrowingList list = make_throwing_list(10, 0);
+        ThrowingKey key(10);
+        fault_injection_test([&]() {
+            list.push_back(key);
+        }, [&]() {
+            return std::vector<const ThrowingList*>{&list};
+        });
+        EXPECT_EQ(list.size(), 11);
+        EXPECT_EQ(list.back().value, 10);
+
+        fault_injection_test([&]() {
+            list.resize(27, ThrowingKey(-1));
+        }, [&]() {
+            return std::vector<const ThrowingList*>{&list};
+        });
+        EXPECT_EQ(list.size(), 27);
+        EXPECT_EQ(list.back().value, -1);
+
+        // Erasing shifts the following keys by copying them, as moving them is not noexcept
+        list.erase(list.begin());
+        EXPECT_EQ(list.front().value, 1);
+        EXPECT_EQ(list.size(), 26);
+        EXPECT_EQ(list.remove(ThrowingKey(-1)), 16);
+        EXPECT_EQ(values(list), std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+    }
+    EXPECT_EQ(ThrowingKey::s_instances, 0);
+
+    ArrayLinkedList<ThrowingKey, std::allocator<ThrowingKey>, 4> inline_list(5);
+    ThrowingKey::s_copies_until_throw = 0;
+    EXPECT_THROW(inline_list.push_back(ThrowingKey(1)), std::runtime_error);
+    ThrowingKey::s_copies_until_throw = -1;
+    EXPECT_TRUE(inline_list.empty());
+    EXPECT_EQ(inline_list.cbegin(), inline_list.cend());
+}
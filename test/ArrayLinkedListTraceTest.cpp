@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "../ArrayLinkedList.h"
+
+#ifndef ARRAY_LINKED_LIST_TRACING
+#error "This test has to be compiled with ARRAY_LINKED_LIST_TRACING defined"
+#endif
+
+TEST(ArrayLinkedListTraceTest, RecordsOperations) {
+    TraceStats& stats = thread_trace_stats();
+    stats.reset();
+
+    ArrayLinkedList<int> list(10);
+    for (int i = 0; i < 100; ++i)
+        list.push_back(i);
+
+    EXPECT_EQ(stats[TraceOperation::PushBack].count, 100);
+    EXPECT_EQ(stats[TraceOperation::PushBack].latency.count(), 100);
+
+    EXPECT_TRUE(list.contains(55));
+    EXPECT_EQ(stats[TraceOperation::FindKey].count, 1);
+    EXPECT_EQ(stats[TraceOperation::FindKey].nodes_traversed, 6);
+
+    EXPECT_EQ(list.at(35), 35);
+    EXPECT_EQ(stats[TraceOperation::GetItemAtIndex].nodes_traversed, 3);
+
+    // Erasing the first item shifts all 99 items behind it across 10 nodes
+    list.erase(list.begin());
+    EXPECT_EQ(stats[TraceOperation::Erase].count, 1);
+    EXPECT_EQ(stats[TraceOperation::Erase].nodes_traversed, 10);
+    EXPECT_EQ(stats[TraceOperation::Erase].elements_shifted, 99);
+
+    list.resize(0);
+    EXPECT_EQ(stats[TraceOperation::RemoveLastNode].count, 10);
+
+    std::string json = stats.to_json();
+    EXPECT_NE(json.find("\"erase\":{\"count\":1,\"nodes_traversed\":10,\"elements_shifted\":99"), std::string::npos);
+    std::string text = stats.to_text();
+    EXPECT_NE(text.find("push_back: 100 calls"), std::string::npos);
+}
+
+TEST(ArrayLinkedListTraceTest, Histogram) {
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 1000; ++i)
+        histogram.record(i);
+
+    EXPECT_EQ(histogram.count(), 1000);
+    EXPECT_EQ(histogram.min(), 1);
+    EXPECT_EQ(histogram.max(), 1000);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+
+    // Buckets are at most 1/8 of their magnitude wide
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(50)), 500.0, 500.0 / 8);
+    EXPECT_NEAR(static_cast<double>(histogram.percentile(99)), 990.0, 990.0 / 8);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../CompressedArrayLinkedList.h"
+
+template <typename T>
+static std::vector<T> to_vector(const CompressedArrayLinkedList<T>& list) {
+    std::vector<T> result;
+    for (T key : list)
+        result.push_back(key);
+    return result;
+}
+
+struct CompressedArrayLinkedListTest : public testing::Test {
+    CompressedArrayLinkedList<uint64_t> ids{64};
+    std::vector<uint64_t> expected;
+
+    virtual void SetUp() override {
+        // Monotone ids with small gaps, like timestamps
+        uint64_t id = 1000000000000;
+        for (uint64_t i = 0; i < 1000; ++i) {
+            id += 1 + i % 7;
+            ids.push_back(id);
+            expected.push_back(id);
+        }
+    }
+};
+
+TEST_F(CompressedArrayLinkedListTest, ReadKeys) {
+    EXPECT_EQ(ids.size(), expected.size());
+
+    size_t i = 0;
+    for (uint64_t id : ids) {
+        EXPECT_EQ(id, expected[i]);
+        ++i;
+    }
+    EXPECT_EQ(i, expected.size());
+
+    for (size_t i = 0; i < expected.size(); i += 37)
+        EXPECT_EQ(ids.at(i), expected[i]);
+    EXPECT_EQ(ids.at(expected.size() - 1), expected.back());
+    EXPECT_THROW(ids.at(expected.size()), std::runtime_error);
+
+    size_t count = 0;
+    ids.for_each_segment([&](const uint64_t* keys, size_t size) {
+        for (size_t j = 0; j < size; ++j)
+            EXPECT_EQ(keys[j], expected[count + j]);
+        count += size;
+    });
+    EXPECT_EQ(count, expected.size());
+
+    // Deltas of at most 7 only need 3 bits instead of 64
+    EXPECT_LT(ids.memory_usage() * 4, expected.size() * sizeof(uint64_t));
+}
+
+TEST_F(CompressedArrayLinkedListTest, Find) {
+    EXPECT_EQ(*ids.find(expected[500]), expected[500]);
+    EXPECT_EQ(*ids.find(expected.back()), expected.back());
+    EXPECT_TRUE(ids.contains(expected.front()));
+    EXPECT_FALSE(ids.contains(expected.front() - 1));
+    EXPECT_FALSE(ids.contains(expected.back() + 1));
+    EXPECT_EQ(ids.find(0), ids.end());
+
+    // Iterating on from a found key continues in the following nodes
+    auto it = ids.find(expected[63]);
+    ++it;
+    EXPECT_EQ(*it, expected[64]);
+}
+
+TEST(CompressedArrayLinkedListUnorderedTest, ReadCopyAndMove) {
+    CompressedArrayLinkedList<uint32_t> list(10);
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < 95; ++i) {
+        uint32_t key = i % 3 == 0 ? UINT32_MAX - i : i * 31 % 17;
+        list.push_back(key);
+        expected.push_back(key);
+    }
+
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(list.at(i), expected[i]);
+    EXPECT_TRUE(list.contains(UINT32_MAX - 33));
+    EXPECT_FALSE(list.contains(UINT32_MAX - 1));
+
+    CompressedArrayLinkedList<uint32_t> copy(list);
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+    EXPECT_EQ(to_vector(copy), expected);
+
+    CompressedArrayLinkedList<uint32_t> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), expected.size());
+
+    ArrayLinkedList<uint32_t> plain(10);
+    for (uint32_t key : expected)
+        plain.push_back(key);
+    CompressedArrayLinkedList<uint32_t> compressed(plain);
+    EXPECT_EQ(to_vector(compressed), expected);
+}
+
+template <typename T>
+static void bit_width_test(size_t node_size) {
+    // Keys of every bit width the type allows, in nodes of increasing and of unordered keys
+    uint64_t state = 12345;
+    for (unsigned bits = 1; bits <= sizeof(T) * 8; ++bits) {
+        uint64_t mask = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        for (bool monotone : {true, false}) {
+            CompressedArrayLinkedList<T> list(node_size);
+            std::vector<T> expected;
+            T key = 0;
+            for (size_t i = 0; i < node_size * 5 + 3; ++i) {
+                state = state * 6364136223846793005 + 1442695040888963407;
+                T value = static_cast<T>((state >> 11 ^ state << 7) & mask);
+                key = monotone ? static_cast<T>(key + value / 4) : value;
+                list.push_back(key);
+                expected.push_back(key);
+            }
+
+            ASSERT_EQ(to_vector(list), expected) << bits << " bits";
+            for (size_t i = 0; i < expected.size(); i += 7) {
+                EXPECT_EQ(list.at(i), expected[i]);
+                EXPECT_EQ(*list.find(expected[i]), expected[i]);
+            }
+
+            size_t count = 0;
+            list.for_each_segment([&](const T* keys, size_t size) {
+                for (size_t j = 0; j < size; ++j)
+                    EXPECT_EQ(keys[j], expected[count + j]);
+                count += size;
+            });
+            EXPECT_EQ(count, expected.size());
+        }
+    }
+}
+
+TEST(CompressedArrayLinkedListBitWidthTest, AllWidths) {
+    // Node sizes that fill whole rows of lanes and ones that leave a partial row
+    for (size_t node_size : {16, 13}) {
+        bit_width_test<uint8_t>(node_size);
+        bit_width_test<uint16_t>(node_size);
+        bit_width_test<uint32_t>(node_size);
+        bit_width_test<uint64_t>(node_size);
+    }
+}
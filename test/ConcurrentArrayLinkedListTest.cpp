@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentArrayLinkedList.h"
+
+TEST(ConcurrentArrayLinkedListTest, SingleThreaded) {
+    ConcurrentArrayLinkedList<int> list(7);
+    for (int i = 0; i < 100; ++i)
+        list.push_back(i);
+
+    auto snapshot = list.snapshot();
+    EXPECT_EQ(snapshot.size(), 100);
+
+    int expected = 0;
+    for (const int& key : snapshot) {
+        EXPECT_EQ(key, expected);
+        ++expected;
+    }
+
+    // Items pushed after the snapshot was taken must not be visible through it
+    list.push_back(100);
+    EXPECT_EQ(snapshot.size(), 100);
+    EXPECT_EQ(list.snapshot().size(), 101);
+}
+
+TEST(ConcurrentArrayLinkedListTest, EmptySnapshot) {
+    ConcurrentArrayLinkedList<int> list;
+    auto snapshot = list.snapshot();
+    EXPECT_EQ(snapshot.begin(), snapshot.end());
+    EXPECT_EQ(snapshot.size(), 0);
+}
+
+/*
+Several threads append increasing values tagged with their thread id while a reader keeps taking snapshots.
+Every snapshot must only contain complete values and the values of each thread must appear in the order they were pushed
+*/
+TEST(ConcurrentArrayLinkedListTest, ConcurrentAppend) {
+    const int thread_count = 8;
+    const int items_per_thread = 20000;
+    ConcurrentArrayLinkedList<std::pair<int, int>> list(13);
+
+    auto check_snapshot = [&](const auto& snapshot) {
+        std::vector<int> last_seen(thread_count, -1);
+        size_t count = 0;
+        for (const auto& [thread, value] : snapshot) {
+            EXPECT_GE(thread, 0);
+            EXPECT_LT(thread, thread_count);
+            EXPECT_GT(value, last_seen[thread]);
+            last_seen[thread] = value;
+            ++count;
+        }
+        return count;
+    };
+
+    std::atomic<bool> done = false;
+    std::thread reader([&]() {
+        while (!done.load())
+            check_snapshot(list.snapshot());
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < thread_count; ++t) {
+        writers.emplace_back([&list, t]() {
+            for (int i = 0; i < items_per_thread; ++i)
+                list.emplace_back(t, i);
+        });
+    }
+
+    for (auto& writer : writers)
+        writer.join();
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(check_snapshot(list.snapshot()), thread_count * items_per_thread);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../ArrayLinkedList.h"
+#include "../HugePageAllocator.h"
+
+TEST(HugePageAllocatorTest, ArrayLinkedList) {
+    ArrayLinkedList<int, HugePageAllocator<int>> list(64);
+    for (int i = 0; i < 100000; ++i)
+        list.push_back(i);
+
+    int expected = 0;
+    for (const int& key : list) {
+        EXPECT_EQ(key, expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 100000);
+
+    // Copies share the arena of the allocator, moves take over the nodes and the allocator
+    ArrayLinkedList<int, HugePageAllocator<int>> copy(list);
+    EXPECT_EQ(copy.get_allocator(), list.get_allocator());
+    EXPECT_EQ(copy.size(), list.size());
+
+    ArrayLinkedList<int, HugePageAllocator<int>> other(64);
+    other.push_back(1);
+    EXPECT_NE(other.get_allocator(), list.get_allocator());
+    other = std::move(copy);
+    EXPECT_EQ(other.get_allocator(), list.get_allocator());
+    EXPECT_EQ(other.back(), 99999);
+
+    // Freed nodes are reused, so refilling the list does not map any new slabs
+    std::shared_ptr<HugePageArena> arena = other.get_allocator().arena();
+    size_t slab_count = arena->slab_count();
+    EXPECT_EQ(other.erase_if([](int key) {
+        return key >= 50000;
+    }), 50000);
+    for (int i = 0; i < 50000; ++i)
+        other.push_back(i);
+    EXPECT_EQ(other.size(), 100000);
+    EXPECT_EQ(other.back(), 49999);
+    EXPECT_EQ(arena->slab_count(), slab_count);
+}
+
+TEST(HugePageAllocatorTest, BlockReuse) {
+    HugePageArena arena;
+    void* first = arena.allocate(256, 8);
+    void* second = arena.allocate(256, 8);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(arena.slab_count(), 1);
+
+    // A freed block is handed out again for the next allocation of the same size
+    arena.deallocate(first, 256, 8);
+    EXPECT_EQ(arena.allocate(256, 8), first);
+    EXPECT_NE(arena.allocate(128, 8), first);
+    EXPECT_EQ(arena.slab_count(), 1);
+
+    // A block freed with a smaller alignment is not handed out for a larger one
+    arena.allocate(16, 8);
+    void* aligned_16 = arena.allocate(64, 16);
+    arena.deallocate(aligned_16, 64, 16);
+    void* aligned_64 = arena.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned_64) % 64, 0);
+    EXPECT_EQ(arena.allocate(64, 16), aligned_16);
+}
+
+TEST(HugePageAllocatorTest, NonTrivialKeys) {
+    HugePageAllocator<std::string> allocator(0);
+    EXPECT_EQ(allocator.arena()->numa_node(), 0);
+
+    ArrayLinkedList<std::string, HugePageAllocator<std::string>> list(7, allocator);
+    for (int i = 0; i < 1000; ++i)
+        list.push_back(std::string(100, 'a' + i % 26));
+
+    auto snapshot = list.snapshot();
+    list.pop_back();
+    EXPECT_EQ(snapshot.size(), 1000);
+    EXPECT_EQ(list.size(), 999);
+    EXPECT_EQ(snapshot.back(), std::string(100, 'a' + 999 % 26));
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "../PersistentArrayLinkedList.h"
+
+template <typename T>
+void expect_equal(const PersistentArrayLinkedList<T>& list, const std::vector<T>& expected) {
+    ASSERT_EQ(list.size(), expected.size());
+    size_t i = 0;
+    for (const T& key : list) {
+        EXPECT_EQ(key, expected[i]);
+        EXPECT_EQ(list.at(i), expected[i]);
+        ++i;
+    }
+    EXPECT_EQ(i, expected.size());
+}
+
+TEST(PersistentArrayLinkedListTest, PushBack) {
+    std::vector<PersistentArrayLinkedList<int>> versions;
+    versions.emplace_back(3);
+    // Enough keys for a tree with more than two levels of branches
+    for (int i = 0; i < 4000; ++i)
+        versions.push_back(versions.back().push_back(i));
+
+    for (size_t version = 0; version < versions.size(); version += 397) {
+        std::vector<int> expected;
+        for (int i = 0; i < static_cast<int>(version); ++i)
+            expected.push_back(i);
+        expect_equal(versions[version], expected);
+    }
+
+    EXPECT_THROW(versions.back().at(4000), std::runtime_error);
+}
+
+TEST(PersistentArrayLinkedListTest, SetAndErase) {
+    ArrayLinkedList<int> source(4);
+    std::vector<int> expected;
+    for (int i = 0; i < 500; ++i) {
+        source.push_back(i);
+        expected.push_back(i);
+    }
+
+    PersistentArrayLinkedList<int> original(source);
+    EXPECT_EQ(original.node_size(), 4);
+    expect_equal(original, expected);
+
+    auto changed = original.set(10, -10).set(499, -499);
+    EXPECT_EQ(changed.at(10), -10);
+    EXPECT_EQ(changed.back(), -499);
+    expect_equal(original, expected);
+
+    // Erase keys at random positions and compare every version against a vector
+    std::mt19937 rng(1234);
+    std::vector<PersistentArrayLinkedList<int>> versions = {original};
+    std::vector<std::vector<int>> expected_versions = {expected};
+    while (!expected.empty()) {
+        size_t index = rng() % expected.size();
+        versions.push_back(versions.back().erase(index));
+        expected.erase(expected.begin() + index);
+        expected_versions.push_back(expected);
+    }
+
+    for (size_t version = 0; version < versions.size(); version += 37)
+        expect_equal(versions[version], expected_versions[version]);
+    EXPECT_TRUE(versions.back().empty());
+    EXPECT_EQ(versions.back().begin(), versions.back().end());
+
+    // Appending after erasing, when leaves are not full anymore
+    auto appended = versions[250].push_back(1000);
+    expected_versions[250].push_back(1000);
+    expect_equal(appended, expected_versions[250]);
+
+    auto refilled = versions.back().push_back(1);
+    expect_equal(refilled, {1});
+}
+
+TEST(PersistentArrayLinkedListTest, InitializerList) {
+    PersistentArrayLinkedList<int> list = {1, 2, 3, 4, 5};
+    expect_equal(list, {1, 2, 3, 4, 5});
+    expect_equal(list.erase(0).erase(3), {2, 3, 4});
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../SoAArrayLinkedList.h"
+
+using RecordList = SoAArrayLinkedList<int64_t, double, std::string>;
+
+struct SoAArrayLinkedListTest : public testing::Test {
+    RecordList list{16};
+
+    virtual void SetUp() override {
+        for (int64_t i = 0; i < 100; ++i)
+            list.push_back(i, i * 0.5, std::to_string(i));
+    }
+};
+
+TEST_F(SoAArrayLinkedListTest, Iteration) {
+    EXPECT_EQ(list.size(), 100);
+
+    int64_t expected = 0;
+    for (auto [id, value, name] : list) {
+        EXPECT_EQ(id, expected);
+        EXPECT_EQ(value, expected * 0.5);
+        EXPECT_EQ(name, std::to_string(expected));
+
+        // The proxy references refer to the stored fields
+        value = -1.0;
+        ++expected;
+    }
+    EXPECT_EQ(expected, 100);
+
+    for (auto it = list.cbegin(); it != list.cend(); ++it)
+        EXPECT_EQ(it.get<1>(), -1.0);
+
+    auto it = list.begin();
+    for (int i = 0; i < 20; ++i)
+        ++it;
+    --it;
+    EXPECT_EQ(it.get<2>(), "19");
+}
+
+TEST_F(SoAArrayLinkedListTest, Columns) {
+    int64_t sum = 0;
+    size_t count = 0;
+    list.for_each_segment<0>([&](const int64_t* ids, size_t size) {
+        EXPECT_LE(size, list.node_size());
+        for (size_t i = 0; i < size; ++i)
+            sum += ids[i];
+        count += size;
+    });
+    EXPECT_EQ(count, 100);
+    EXPECT_EQ(sum, 99 * 100 / 2);
+
+    list.for_each_segment<1>([](double* values, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            values[i] *= 2;
+    });
+    EXPECT_EQ(std::get<1>(list.at(10)), 10.0);
+    EXPECT_EQ(std::get<2>(list.at(10)), "10");
+    EXPECT_THROW(list.at(100), std::runtime_error);
+}
+
+TEST_F(SoAArrayLinkedListTest, CopyMoveAndRemove) {
+    RecordList copy(list);
+    std::get<2>(copy.at(0)) = "changed";
+    EXPECT_EQ(std::get<2>(list.at(0)), "0");
+
+    RecordList moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 100);
+    EXPECT_EQ(std::get<2>(moved.at(0)), "changed");
+
+    moved = list;
+    EXPECT_EQ(std::get<2>(moved.at(0)), "0");
+
+    for (int i = 0; i < 100; ++i)
+        moved.pop_back();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.begin(), moved.end());
+
+    moved.push_back(std::make_tuple(int64_t(1), 2.0, std::string("3")));
+    EXPECT_EQ(moved.at(0), std::make_tuple(int64_t(1), 2.0, std::string("3")));
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+}
+
+// Record made tuple-like by specializing std::tuple_size and std::tuple_element and providing get
+struct Sample {
+    int64_t time;
+    double value;
+};
+
+namespace std {
+template <>
+struct tuple_size<Sample> : std::integral_constant<size_t, 2> {};
+
+template <>
+struct tuple_element<0, Sample> {
+    using type = int64_t;
+};
+
+template <>
+struct tuple_element<1, Sample> {
+    using type = double;
+};
+}
+
+template <size_t I>
+const std::tuple_element_t<I, Sample>& get(const Sample& sample) {
+    if constexpr (I == 0)
+        return sample.time;
+    else
+        return sample.value;
+}
+
+TEST(SoAArrayLinkedListRecordTest, TupleLikeRecords) {
+    SoAArrayLinkedList<Sample> samples(8);
+    static_assert(std::is_same_v<SoAArrayLinkedList<Sample>::field_type<0>, int64_t>);
+    static_assert(std::is_same_v<SoAArrayLinkedList<Sample>::field_type<1>, double>);
+    for (int64_t i = 0; i < 20; ++i)
+        samples.push_back(Sample{i, i * 1.5});
+    samples.push_back(int64_t(20), 30.0);
+    EXPECT_EQ(samples.size(), 21);
+
+    double sum = 0;
+    samples.for_each_segment<1>([&](const double* values, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            sum += values[i];
+    });
+    EXPECT_EQ(sum, 20 * 21 / 2 * 1.5);
+    EXPECT_EQ(std::get<0>(samples.at(20)), 20);
+
+    SoAArrayLinkedList<Sample> copy(samples);
+    EXPECT_EQ(std::get<1>(copy.at(3)), 4.5);
+
+    // Standard tuple-like types are split as well, other single types make a single column
+    SoAArrayLinkedList<std::pair<int, std::string>> pairs;
+    pairs.push_back(std::make_pair(1, std::string("one")));
+    pairs.push_back(2, "two");
+    EXPECT_EQ(std::get<1>(pairs.at(1)), "two");
+    static_assert(std::is_same_v<SoAArrayLinkedList<std::pair<int, std::string>>::field_type<1>, std::string>);
+
+    SoAArrayLinkedList<std::array<float, 3>> points;
+    points.push_back(std::array<float, 3>{1.0f, 2.0f, 3.0f});
+    EXPECT_EQ(std::get<2>(points.at(0)), 3.0f);
+
+    SoAArrayLinkedList<int> ints;
+    ints.push_back(5);
+    EXPECT_EQ(std::get<0>(ints.at(0)), 5);
+}
+
+// Field that counts its instances and throws from its default constructor or copy assignment when asked to
+struct ThrowingField {
+    static int s_instances;
+    // Number of default constructions that succeed before one throws, or -1 to never throw
+    static int s_constructions_until_throw;
+    static bool s_throw_on_assign;
+
+    int value;
+
+    ThrowingField(int value = 0) :
+        value(value) {
+        if (s_constructions_until_throw == 0)
+            throw std::runtime_error("Construction failed");
+        if (s_constructions_until_throw > 0)
+            --s_constructions_until_throw;
+        ++s_instances;
+    }
+
+    ThrowingField(const ThrowingField& other) :
+        value(other.value) {
+        ++s_instances;
+    }
+
+    ~ThrowingField() {
+        --s_instances;
+    }
+
+    ThrowingField& operator=(const ThrowingField& other) {
+        if (s_throw_on_assign)
+            throw std::runtime_error("Assignment failed");
+        value = other.value;
+        return *this;
+    }
+};
+
+int ThrowingField::s_instances = 0;
+int ThrowingField::s_constructions_until_throw = -1;
+bool ThrowingField::s_throw_on_assign = false;
+
+TEST(SoAArrayLinkedListRecordTest, ExceptionSafety) {
+    {
+        SoAArrayLinkedList<ThrowingField, ThrowingField> list(4);
+        for (int i = 0; i < 4; ++i)
+            list.push_back(ThrowingField(i), ThrowingField(-i));
+        ThrowingField first(4);
+        ThrowingField second(-4);
+
+        // The first column of a node whose second column cannot be allocated is freed again
+        ThrowingField::s_constructions_until_throw = 4;
+        EXPECT_THROW(list.push_back(first, second), std::runtime_error);
+        ThrowingField::s_constructions_until_throw = -1;
+        EXPECT_EQ(list.size(), 4);
+        EXPECT_EQ(ThrowingField::s_instances, 4 * 2 + 2);
+
+        // A node appended for a record that cannot be assigned is removed again
+        ThrowingField::s_throw_on_assign = true;
+        EXPECT_THROW(list.push_back(first, second), std::runtime_error);
+        ThrowingField::s_throw_on_assign = false;
+        EXPECT_EQ(list.size(), 4);
+        EXPECT_EQ(std::get<0>(list.at(3)).value, 3);
+
+        list.push_back(first, second);
+        EXPECT_EQ(list.size(), 5);
+        int expected = 0;
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            EXPECT_EQ(it.get<1>().value, -expected);
+            ++expected;
+        }
+        EXPECT_EQ(expected, 5);
+    }
+    EXPECT_EQ(ThrowingField::s_instances, 0);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../StableArrayLinkedList.h"
+
+TEST(StableArrayLinkedListTest, InsertAndGet) {
+    StableArrayLinkedList<int> list(4);
+    std::vector<StableArrayLinkedList<int>::Handle> handles;
+    for (int i = 0; i < 20; ++i)
+        handles.push_back(list.insert(i));
+
+    EXPECT_EQ(list.size(), 20);
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_NE(list.get(handles[i]), nullptr);
+        EXPECT_EQ(*list.get(handles[i]), i);
+    }
+
+    int expected = 0;
+    for (const int& key : list) {
+        EXPECT_EQ(key, expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 20);
+}
+
+TEST(StableArrayLinkedListTest, HandlesSurviveErase) {
+    StableArrayLinkedList<std::string> list(3);
+    std::unordered_map<std::string, StableArrayLinkedList<std::string>::Handle> index;
+    for (int i = 0; i < 30; ++i) {
+        std::string key = std::to_string(i);
+        index[key] = list.emplace(key);
+    }
+
+    // Erase every third item, the other handles must still refer to the same items
+    for (int i = 0; i < 30; i += 3)
+        EXPECT_TRUE(list.erase(index[std::to_string(i)]));
+
+    EXPECT_EQ(list.size(), 20);
+    for (int i = 0; i < 30; ++i) {
+        auto handle = index[std::to_string(i)];
+        if (i % 3 == 0) {
+            EXPECT_FALSE(list.contains(handle));
+            EXPECT_EQ(list.get(handle), nullptr);
+            EXPECT_FALSE(list.erase(handle));
+        } else {
+            ASSERT_TRUE(list.contains(handle));
+            EXPECT_EQ(*list.get(handle), std::to_string(i));
+        }
+    }
+
+    // Iteration skips erased items
+    size_t count = 0;
+    for (auto it = list.cbegin(); it != list.cend(); ++it) {
+        EXPECT_NE(std::stoi(*it) % 3, 0);
+        EXPECT_EQ(list.get(it.handle()), &*it);
+        ++count;
+    }
+    EXPECT_EQ(count, list.size());
+
+    // Freed slots are reused, but stale handles must not see the new items
+    auto stale = index["0"];
+    auto reused = list.insert("new");
+    EXPECT_FALSE(list.contains(stale));
+    EXPECT_EQ(*list.get(reused), "new");
+    EXPECT_EQ(list.size(), 21);
+}
+
+TEST(StableArrayLinkedListTest, Move) {
+    StableArrayLinkedList<int> list;
+    auto handle = list.insert(42);
+    list.erase(list.insert(1));
+
+    StableArrayLinkedList<int> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(*moved.get(handle), 42);
+    EXPECT_EQ(moved.size(), 1);
+
+    // The free slot moves along with the nodes
+    moved.insert(2);
+    EXPECT_EQ(moved.size(), 2);
+
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.begin(), moved.end());
+    moved.insert(3);
+    EXPECT_EQ(*moved.begin(), 3);
+}
+
+TEST(StableArrayLinkedListTest, HandlesAfterClearAndAssignment) {
+    StableArrayLinkedList<std::string> list(4);
+    std::vector<StableArrayLinkedList<std::string>::Handle> handles;
+    for (int i = 0; i < 10; ++i)
+        handles.push_back(list.insert(std::to_string(i)));
+    list.erase(handles[3]);
+
+    // Clearing keeps the slots, so the old handles are detected as stale instead of pointing to freed memory
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+    for (const auto& handle : handles) {
+        EXPECT_FALSE(list.contains(handle));
+        EXPECT_EQ(list.get(handle), nullptr);
+        EXPECT_FALSE(list.erase(handle));
+    }
+
+    // The cleared slots are reused before new ones are added
+    auto reused = list.insert("reused");
+    EXPECT_EQ(*list.get(reused), "reused");
+    for (const auto& handle : handles)
+        EXPECT_FALSE(list.contains(handle));
+
+    // The slots of a list that is assigned to are handed to the moved from list
+    StableArrayLinkedList<std::string> other(4);
+    auto other_handle = other.insert("other");
+    list = std::move(other);
+    EXPECT_EQ(list.size(), 1);
+    EXPECT_EQ(*list.get(other_handle), "other");
+    EXPECT_TRUE(other.empty());
+    EXPECT_FALSE(other.contains(reused));
+    EXPECT_FALSE(list.contains(reused));
+    EXPECT_EQ(other.begin(), other.end());
+    other.insert("again");
+    EXPECT_EQ(other.size(), 1);
+}